@@ -3,6 +3,7 @@
 #include <queue>
 #include <limits>
 #include <utility>
+#include "../structure/Nonlinear/IndexedHeap.hpp"
 
 // Template-based Dijkstra's algorithm for weighted graphs (adjacency list)
 template<typename W>
@@ -24,4 +25,25 @@ std::vector<W> dijkstra(const std::vector<std::vector<std::pair<int, W>>>& adj,
         }
     }
     return dist;
-} 
\ No newline at end of file
+} 
+
+// Same result using an indexed heap with decrease-key: each vertex is queued
+// at most once, so the queue never holds more than V entries
+template<typename W, size_t Arity = 4>
+std::vector<W> dijkstra_indexed(const std::vector<std::vector<std::pair<int, W>>>& adj, int src) {
+    const W INF = std::numeric_limits<W>::max();
+    std::vector<W> dist(adj.size(), INF);
+    dist[src] = 0;
+    IndexedHeap<W, std::less<W>, Arity> pq(adj.size());
+    pq.push(src, 0);
+    while (!pq.empty()) {
+        int u = static_cast<int>(pq.pop());
+        for (const auto& [v, w] : adj[u]) {
+            if (dist[v] > dist[u] + w) {
+                dist[v] = dist[u] + w;
+                pq.push_or_update(v, dist[v]);
+            }
+        }
+    }
+    return dist;
+}
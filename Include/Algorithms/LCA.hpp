@@ -1,5 +1,9 @@
 #pragma once
 #include <unordered_set>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include "../structure/Nonlinear/SparseTable.hpp"
 
 // Template-based LCA for binary trees with parent pointers
 template<typename Node>
@@ -14,4 +18,65 @@ Node* lca(Node* a, Node* b) {
         b = b->parent;
     }
     return nullptr;
-} 
\ No newline at end of file
+} 
+
+// LCA index over a rooted tree given as an adjacency list (undirected or
+// children only), answering each query in O(1) after O(n log n) setup.
+// The Euler tour records (depth, vertex) each time the walk enters or
+// returns to a vertex; the LCA of u and v is the shallowest entry between
+// their first visits, a range-min query on a SparseTable. A cycle reachable
+// from the root throws std::invalid_argument, and a neighbour index outside
+// [0, n) throws std::out_of_range.
+class EulerTourLCA {
+    using Entry = std::pair<int, int>;
+    std::vector<int> first;
+    SparseTable<Entry, MinMonoid<Entry>> rmq;
+public:
+    EulerTourLCA(const std::vector<std::vector<int>>& adj, int root = 0) {
+        int n = static_cast<int>(adj.size());
+        if (n == 0) return;
+        if (root < 0 || root >= n) throw std::out_of_range("LCA root out of range");
+        first.assign(n, -1);
+        std::vector<Entry> tour;
+        tour.reserve(2 * n - 1);
+        // Iterative DFS; each frame is (vertex, parent, next neighbour)
+        struct Frame { int v, parent; size_t next; };
+        std::vector<Frame> stack{{root, -1, 0}};
+        first[root] = 0;
+        tour.push_back({0, root});
+        int visits = 1;
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.next < adj[top.v].size()) {
+                int c = adj[top.v][top.next++];
+                if (c < 0 || c >= n) throw std::out_of_range("LCA neighbour out of range");
+                if (c == top.parent) continue;
+                // More visits than vertices means a cycle
+                if (visits++ == n) throw std::invalid_argument("LCA adjacency list is not a tree");
+                int depth = static_cast<int>(stack.size());
+                first[c] = static_cast<int>(tour.size());
+                tour.push_back({depth, c});
+                stack.push_back({c, top.v, 0});
+            } else {
+                stack.pop_back();
+                if (!stack.empty()) tour.push_back({static_cast<int>(stack.size()) - 1, stack.back().v});
+            }
+        }
+        rmq = SparseTable<Entry, MinMonoid<Entry>>(tour);
+    }
+
+    int query(int u, int v) const {
+        int a = firstVisit(u), b = firstVisit(v);
+        if (a > b) std::swap(a, b);
+        return rmq.query(a, b + 1).second;
+    }
+    int depth(int v) const { return rmq[firstVisit(v)].first; }
+    int distance(int u, int v) const { return depth(u) + depth(v) - 2 * depth(query(u, v)); }
+
+private:
+    int firstVisit(int v) const {
+        int i = first.at(v);
+        if (i < 0) throw std::invalid_argument("LCA vertex not reachable from the root");
+        return i;
+    }
+};
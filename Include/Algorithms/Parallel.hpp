@@ -0,0 +1,41 @@
+#pragma once
+#include <future>
+#include <thread>
+#include <utility>
+
+namespace algo {
+    // Fork depth that yields about twice as many leaf tasks as hardware threads
+    inline int fork_depth() {
+        unsigned threads = std::thread::hardware_concurrency();
+        int depth = 1;
+        while ((1u << depth) < 2 * threads) ++depth;
+        return depth;
+    }
+
+    // Fork-join: runs f on another thread and g on the caller, then joins.
+    // Recursive algorithms pass depth - 1 down; at depth 0 both run inline.
+    template<typename F, typename G>
+    void parallel_invoke(int depth, F&& f, G&& g) {
+        if (depth <= 0) {
+            f();
+            g();
+            return;
+        }
+        auto forked = std::async(std::launch::async, std::forward<F>(f));
+        g();
+        forked.get();
+    }
+
+    // Calls f(i) for i in [first, last), splitting ranges larger than grain
+    template<typename Index, typename F>
+    void parallel_for(Index first, Index last, Index grain, const F& f, int depth = fork_depth()) {
+        if (last - first <= grain || depth <= 0) {
+            for (Index i = first; i < last; ++i) f(i);
+            return;
+        }
+        Index mid = first + (last - first) / 2;
+        parallel_invoke(depth,
+            [&] { parallel_for(first, mid, grain, f, depth - 1); },
+            [&] { parallel_for(mid, last, grain, f, depth - 1); });
+    }
+}
\ No newline at end of file
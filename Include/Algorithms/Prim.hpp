@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <utility>
+#include "../structure/Nonlinear/IndexedHeap.hpp"
+
+// Template-based Prim's algorithm for undirected weighted graphs (adjacency
+// list with both directions of every edge). Grows the minimum spanning tree
+// of root's component; each vertex sits in an indexed heap at most once and
+// is re-keyed with decrease_key. Returns the total weight and each vertex's
+// tree parent (-1 for the root and for vertices it cannot reach).
+template<typename W, size_t Arity = 4>
+std::pair<W, std::vector<int>> prim(const std::vector<std::vector<std::pair<int, W>>>& adj, int root = 0) {
+    const W INF = std::numeric_limits<W>::max();
+    std::vector<W> best(adj.size(), INF);
+    std::vector<int> parent(adj.size(), -1);
+    std::vector<bool> inTree(adj.size(), false);
+    W total = 0;
+    if (adj.empty()) return {total, parent};
+    IndexedHeap<W, std::less<W>, Arity> pq(adj.size());
+    best[root] = 0;
+    pq.push(root, 0);
+    while (!pq.empty()) {
+        int u = static_cast<int>(pq.pop());
+        inTree[u] = true;
+        total += best[u];
+        for (const auto& [v, w] : adj[u]) {
+            if (!inTree[v] && w < best[v]) {
+                best[v] = w;
+                parent[v] = u;
+                pq.push_or_update(v, w);
+            }
+        }
+    }
+    return {total, parent};
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include "Parallel.hpp"
+#include "../structure/Nonlinear/NaryTree.hpp"
+#include "../structure/Nonlinear/FlatNaryTree.hpp"
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace algo {
+    namespace detail {
+        // Bottom-up reduction over a tree laid out in preorder: node i's
+        // subtree is [i, i + size[i]) and its children are found by skipping
+        // whole subtrees. Subtrees below the cutoff are reduced by one
+        // backward scan; larger ones split their children into two halves of
+        // similar total size and fork, so tasks stay balanced on skewed trees.
+        template<typename R, typename Size, typename Value, typename LeafFn, typename CombineFn>
+        class TreeReducer {
+            Size size;
+            Value value;
+            LeafFn& leafFn;
+            CombineFn& combineFn;
+            size_t cutoff;
+            std::vector<R>& out;
+        public:
+            TreeReducer(Size sizes, Value v, LeafFn& leaf, CombineFn& combine,
+                        size_t grain, std::vector<R>& results)
+                : size(sizes), value(v), leafFn(leaf), combineFn(combine), cutoff(grain), out(results) {}
+
+            void reduce(size_t node, int depth) {
+                // Walk down single-child chains without recursing; they are
+                // folded back up once the branching node below is done
+                size_t top = node;
+                while (size(node) > cutoff && depth > 0 && size(node) > 1 && size(node + 1) == size(node) - 1)
+                    ++node;
+                if (size(node) <= cutoff || depth <= 0 || size(node) == 1) {
+                    sequential(node);
+                } else {
+                    reduceSiblings(node + 1, node + size(node), depth);
+                    fold(node);
+                }
+                while (node-- > top) fold(node);
+            }
+        private:
+            void fold(size_t node) {
+                R acc = leafFn(value(node));
+                for (size_t c = node + 1; c < node + size(node); c += size(c)) acc = combineFn(std::move(acc), out[c]);
+                out[node] = std::move(acc);
+            }
+            // Children are complete before their parent in a backward scan
+            // over whole subtrees [first, last)
+            void sequential(size_t first, size_t last) {
+                for (size_t i = last; i-- > first;) fold(i);
+            }
+            void sequential(size_t node) { sequential(node, node + size(node)); }
+            // Reduces the adjacent sibling subtrees that make up [first, last),
+            // forking at the sibling boundary closest to the middle
+            void reduceSiblings(size_t first, size_t last, int depth) {
+                if (first + size(first) == last) {
+                    reduce(first, depth);
+                    return;
+                }
+                if (depth <= 0 || last - first <= cutoff) {
+                    sequential(first, last);
+                    return;
+                }
+                size_t mid = first + size(first);
+                while (2 * (mid - first) < last - first && mid + size(mid) < last) mid += size(mid);
+                parallel_invoke(depth,
+                    [&] { reduceSiblings(first, mid, depth - 1); },
+                    [&] { reduceSiblings(mid, last, depth - 1); });
+            }
+        };
+
+        template<typename R, typename Size, typename Value, typename LeafFn, typename CombineFn>
+        std::vector<R> reduce_preorder(size_t n, Size size, Value value, LeafFn& leaf_fn,
+                                       CombineFn& combine_fn, size_t cutoff) {
+            static_assert(!std::is_same<R, bool>::value,
+                          "tree_reduce writes results concurrently; std::vector<bool> is not safe for that");
+            std::vector<R> results(n);
+            if (n == 0) return results;
+            TreeReducer<R, Size, Value, LeafFn, CombineFn>(size, value, leaf_fn, combine_fn, cutoff, results)
+                .reduce(0, fork_depth());
+            return results;
+        }
+    }
+
+    // Parallel post-order aggregation. For each node, leaf_fn(value) gives
+    // the node's own contribution and combine_fn(acc, childResult) folds in
+    // each child's result, left to right. Returns the aggregate of every
+    // subtree, indexed by the node's preorder position (the order of
+    // NaryTree::traverse and the indices of FlatNaryTree). The result type
+    // must be default-constructible, and both functions may run on several
+    // threads at once. Subtrees of at most cutoff nodes are reduced
+    // sequentially.
+    template<typename T, typename LeafFn, typename CombineFn>
+    auto tree_reduce(const FlatNaryTree<T>& tree, LeafFn leaf_fn, CombineFn combine_fn, size_t cutoff = 1 << 14) {
+        using R = std::decay_t<std::invoke_result_t<LeafFn&, const T&>>;
+        auto size = [&](size_t i) -> size_t { return tree.subtree_size(static_cast<uint32_t>(i)); };
+        auto value = [&](size_t i) -> const T& { return tree[static_cast<uint32_t>(i)]; };
+        return detail::reduce_preorder<R>(tree.size(), size, value, leaf_fn, combine_fn, cutoff);
+    }
+
+    // As above; nodes receives the NaryTree node at each preorder position
+    template<typename T, typename LeafFn, typename CombineFn>
+    auto tree_reduce(const NaryTree<T>& tree, LeafFn leaf_fn, CombineFn combine_fn,
+                     std::vector<const typename NaryTree<T>::Node*>& nodes, size_t cutoff = 1 << 14) {
+        using Node = typename NaryTree<T>::Node;
+        using R = std::decay_t<std::invoke_result_t<LeafFn&, const T&>>;
+        // Iterative preorder listing; sizes are summed into parents backwards
+        nodes.clear();
+        std::vector<size_t> parents;
+        if (tree.root) {
+            std::vector<std::pair<const Node*, size_t>> stack{{tree.root.get(), 0}};
+            while (!stack.empty()) {
+                auto [node, p] = stack.back();
+                stack.pop_back();
+                size_t id = nodes.size();
+                nodes.push_back(node);
+                parents.push_back(p);
+                for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+                    stack.emplace_back(it->get(), id);
+            }
+        }
+        std::vector<size_t> sizes(nodes.size(), 1);
+        for (size_t i = sizes.size(); i-- > 1;) sizes[parents[i]] += sizes[i];
+        auto size = [&](size_t i) { return sizes[i]; };
+        auto value = [&](size_t i) -> const T& { return nodes[i]->data; };
+        return detail::reduce_preorder<R>(sizes.size(), size, value, leaf_fn, combine_fn, cutoff);
+    }
+    template<typename T, typename LeafFn, typename CombineFn>
+    auto tree_reduce(const NaryTree<T>& tree, LeafFn leaf_fn, CombineFn combine_fn, size_t cutoff = 1 << 14) {
+        std::vector<const typename NaryTree<T>::Node*> nodes;
+        return tree_reduce(tree, std::move(leaf_fn), std::move(combine_fn), nodes, cutoff);
+    }
+}
@@ -1,114 +1,403 @@
 #pragma once
 #include "Tree.hpp"
+#include "../../Algorithms/Parallel.hpp"
 #include <algorithm>
 #include <functional>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <cstddef>
+#include <vector>
+
+// AVL node: caches its subtree height so balancing is O(1) per level,
+// and its subtree size for order-statistic queries. Derived node types add
+// their own metadata by overriding augment(), which runs whenever height and
+// size are recomputed (including inside rotations).
+template<typename T, typename Derived>
+struct AVLNodeBase {
+    T data;
+    Derived* left;
+    Derived* right;
+    int height;
+    size_t size;
+    template<typename... Args>
+    explicit AVLNodeBase(Args&&... args)
+        : data(std::forward<Args>(args)...), left(nullptr), right(nullptr), height(1), size(1) {}
+    void augment() {}
+};
 
-// Template-based AVLTree as a child of Tree<T>
 template<typename T>
-class AVLTree : public Tree<T> {
-    using Node = typename Tree<T>::Node;
+struct AVLNode : AVLNodeBase<T, AVLNode<T>> {
+    using AVLNodeBase<T, AVLNode<T>>::AVLNodeBase;
+};
+
+// Template-based AVLTree as a child of Tree<T>
+// insert/remove are iterative: they record the search path and retrace it
+// bottom-up, so each operation is O(log n) with no recursion.
+// The node type is the allocator's value_type, so augmented trees (see
+// IntervalTree) only need to pass an allocator for their own node.
+template<typename T, typename Alloc = std::allocator<AVLNode<T>>>
+class AVLTree : public Tree<T, typename std::allocator_traits<Alloc>::value_type, Alloc> {
+    using Node = typename std::allocator_traits<Alloc>::value_type;
+    using Base = Tree<T, Node, Alloc>;
+    // AVL height is below 1.45 * log2(n + 2), so 96 covers any 64-bit size
+    static constexpr int kMaxHeight = 96;
 public:
-    void insert(const T& value) {
-        this->root = insertRec(this->root, value);
+    using Base::Base;
+
+    bool insert(const T& value) {
+        return insertWith(value, [&] { return this->create_node(value); });
+    }
+    bool insert(T&& value) {
+        return insertWith(value, [&] { return this->create_node(std::move(value)); });
+    }
+    // Builds a perfectly balanced tree from sorted input in O(n);
+    // duplicates are dropped
+    template<typename It>
+    static AVLTree from_sorted(It first, It last, const Alloc& alloc = Alloc()) {
+        std::vector<T> values(first, last);
+        values.erase(std::unique(values.begin(), values.end(),
+                                 [](const T& a, const T& b) { return !(a < b) && !(b < a); }),
+                     values.end());
+        AVLTree tree(alloc);
+        tree.root = tree.buildBalanced(values, 0, values.size());
+        return tree;
+    }
+
+    // Join-based bulk operations. Each consumes its arguments and reuses
+    // their nodes; set operations cost O(m log(n/m + 1)) work for sizes
+    // m <= n and fork both halves in parallel on large inputs.
+
+    // Splits into (elements < key, elements >= key) in O(log n)
+    static std::pair<AVLTree, AVLTree> split(AVLTree tree, const T& key) {
+        Node *left, *match, *right;
+        splitNode(tree.root, key, left, match, right);
+        tree.root = nullptr;
+        if (match) right = insertMin(right, match);
+        AVLTree lo(tree.alloc), hi(tree.alloc);
+        lo.root = left;
+        hi.root = right;
+        return {std::move(lo), std::move(hi)};
+    }
+    // Concatenates two trees where every element of left < every element
+    // of right, in O(|height(left) - height(right)| + log n)
+    static AVLTree join(AVLTree left, AVLTree right) {
+        requireSameAllocator(left, right);
+        AVLTree tree(left.alloc);
+        tree.root = join2(left.root, right.root);
+        left.root = right.root = nullptr;
+        return tree;
+    }
+    static AVLTree set_union(AVLTree a, AVLTree b) {
+        return combine(std::move(a), std::move(b), &AVLTree::unionRec);
+    }
+    static AVLTree set_intersection(AVLTree a, AVLTree b) {
+        return combine(std::move(a), std::move(b), &AVLTree::intersectRec);
+    }
+    // Elements of a that are not in b
+    static AVLTree set_difference(AVLTree a, AVLTree b) {
+        return combine(std::move(a), std::move(b), &AVLTree::differenceRec);
+    }
+
+    // Constructs the value in place; it is discarded if already present
+    template<typename... Args>
+    bool emplace(Args&&... args) {
+        Node* node = this->create_node(std::forward<Args>(args)...);
+        bool inserted = insertWith(node->data, [&] { return node; });
+        if (!inserted) this->destroy_node(node);
+        return inserted;
+    }
+    bool remove(const T& value) {
+        Node** path[kMaxHeight];
+        int depth = 0;
+        Node** link = &this->root;
+        while (*link) {
+            Node* node = *link;
+            if (value < node->data) { path[depth++] = link; link = &node->left; }
+            else if (node->data < value) { path[depth++] = link; link = &node->right; }
+            else break;
+        }
+        Node* node = *link;
+        if (!node) return false;
+        if (!node->left || !node->right) {
+            *link = node->left ? node->left : node->right;
+        } else {
+            // Relink the in-order successor into node's place
+            int nodeDepth = depth;
+            path[depth++] = link;
+            Node** succLink = &node->right;
+            while ((*succLink)->left) {
+                path[depth++] = succLink;
+                succLink = &(*succLink)->left;
+            }
+            Node* succ = *succLink;
+            *succLink = succ->right;
+            succ->left = node->left;
+            succ->right = node->right;
+            succ->height = node->height;
+            *link = succ;
+            if (depth > nodeDepth + 1) path[nodeDepth + 1] = &succ->right;
+        }
+        this->destroy_node(node);
+        retrace(path, depth);
+        return true;
+    }
+    bool contains(const T& value) const {
+        Node* node = this->root;
+        while (node) {
+            if (value < node->data) node = node->left;
+            else if (node->data < value) node = node->right;
+            else return true;
+        }
+        return false;
+    }
+    int height() const { return height(this->root); }
+    size_t size() const { return size(this->root); }
+    bool empty() const { return !this->root; }
+
+    // Order statistics: k-th smallest (0-based)
+    const T& select(size_t k) const {
+        if (k >= size()) throw std::out_of_range("AVLTree select index out of range");
+        Node* node = this->root;
+        while (true) {
+            size_t leftSize = size(node->left);
+            if (k < leftSize) node = node->left;
+            else if (k == leftSize) return node->data;
+            else { k -= leftSize + 1; node = node->right; }
+        }
+    }
+    // Number of elements strictly less than value
+    size_t rank(const T& value) const {
+        size_t r = 0;
+        Node* node = this->root;
+        while (node) {
+            if (node->data < value) { r += size(node->left) + 1; node = node->right; }
+            else node = node->left;
+        }
+        return r;
     }
-    void remove(const T& value) {
-        this->root = removeRec(this->root, value);
+    // Number of elements in [lo, hi)
+    size_t count_range(const T& lo, const T& hi) const {
+        if (!(lo < hi)) return 0;
+        return rank(hi) - rank(lo);
+    }
+
+    using typename Base::const_iterator;
+    using typename Base::iterator;
+
+    // Iterator to the element of rank k (end() if k >= size()), O(log n)
+    const_iterator iterator_at(size_t k) const {
+        const_iterator it = this->end();
+        if (k >= size()) return it;
+        Node* node = this->root;
+        while (true) {
+            Base::push_path(it, node);
+            size_t leftSize = size(node->left);
+            if (k < leftSize) node = node->left;
+            else if (k == leftSize) break;
+            else { k -= leftSize + 1; node = node->right; }
+        }
+        return it;
     }
 private:
-    int height(Node* node) const {
-        if (!node) return 0;
-        return 1 + std::max(height(node->left), height(node->right));
+    // Below this combined size set operations stop forking
+    static constexpr size_t kParallelCutoff = 1 << 14;
+
+    Node* buildBalanced(std::vector<T>& values, size_t lo, size_t hi) {
+        if (lo >= hi) return nullptr;
+        size_t mid = lo + (hi - lo) / 2;
+        Node* node = this->create_node(std::move(values[mid]));
+        node->left = buildBalanced(values, lo, mid);
+        node->right = buildBalanced(values, mid + 1, hi);
+        update(node);
+        return node;
+    }
+    // Joins l < k < r where k is a detached node
+    static Node* joinNodes(Node* l, Node* k, Node* r) {
+        if (height(l) > height(r) + 1) {
+            l->right = joinNodes(l->right, k, r);
+            return rebalance(l);
+        }
+        if (height(r) > height(l) + 1) {
+            r->left = joinNodes(l, k, r->left);
+            return rebalance(r);
+        }
+        k->left = l;
+        k->right = r;
+        update(k);
+        return k;
     }
-    int balanceFactor(Node* node) const {
+    static Node* removeMax(Node* node, Node*& max) {
+        if (!node->right) {
+            max = node;
+            return node->left;
+        }
+        node->right = removeMax(node->right, max);
+        return rebalance(node);
+    }
+    static Node* insertMin(Node* node, Node* min) {
+        if (!node) {
+            min->left = min->right = nullptr;
+            update(min);
+            return min;
+        }
+        node->left = insertMin(node->left, min);
+        return rebalance(node);
+    }
+    static Node* join2(Node* l, Node* r) {
+        if (!l) return r;
+        Node* max;
+        l = removeMax(l, max);
+        return joinNodes(l, max, r);
+    }
+    // Splits node into (< key), the node equal to key (or null), (> key)
+    static void splitNode(Node* node, const T& key, Node*& l, Node*& match, Node*& r) {
+        if (!node) {
+            l = match = r = nullptr;
+        } else if (key < node->data) {
+            Node* rl;
+            splitNode(node->left, key, l, match, rl);
+            r = joinNodes(rl, node, node->right);
+        } else if (node->data < key) {
+            Node* lr;
+            splitNode(node->right, key, lr, match, r);
+            l = joinNodes(node->left, node, lr);
+        } else {
+            l = node->left;
+            r = node->right;
+            match = node;
+            node->left = node->right = nullptr;
+        }
+    }
+
+    using SetOp = Node* (AVLTree::*)(Node*, Node*, int);
+    static AVLTree combine(AVLTree a, AVLTree b, SetOp op) {
+        requireSameAllocator(a, b);
+        AVLTree tree(a.alloc);
+        // Stateful allocators (arenas) are not thread-safe, so only fork
+        // when nodes come from a stateless allocator
+        int depth = std::allocator_traits<Alloc>::is_always_equal::value ? algo::fork_depth() : 0;
+        tree.root = (tree.*op)(a.root, b.root, depth);
+        a.root = b.root = nullptr;
+        return tree;
+    }
+    // Nodes move between the trees, so they must share an allocator
+    static void requireSameAllocator(const AVLTree& a, const AVLTree& b) {
+        if (!(a.alloc == b.alloc))
+            throw std::invalid_argument("AVLTree operands must share an allocator");
+    }
+    template<typename F, typename G>
+    static void fork(int depth, size_t work, F&& f, G&& g) {
+        algo::parallel_invoke(work >= kParallelCutoff ? depth : 0, std::forward<F>(f), std::forward<G>(g));
+    }
+    Node* unionRec(Node* a, Node* b, int depth) {
+        if (!a) return b;
+        if (!b) return a;
+        Node *bl, *match, *br, *l, *r;
+        splitNode(b, a->data, bl, match, br);
+        if (match) this->destroy_node(match);
+        Node *al = a->left, *ar = a->right;
+        fork(depth, size(a) + size(bl) + size(br),
+             [&] { l = unionRec(al, bl, depth - 1); },
+             [&] { r = unionRec(ar, br, depth - 1); });
+        return joinNodes(l, a, r);
+    }
+    Node* intersectRec(Node* a, Node* b, int depth) {
+        if (!a || !b) {
+            this->clear(a);
+            this->clear(b);
+            return nullptr;
+        }
+        Node *bl, *match, *br, *l, *r;
+        splitNode(b, a->data, bl, match, br);
+        Node *al = a->left, *ar = a->right;
+        fork(depth, size(a) + size(bl) + size(br),
+             [&] { l = intersectRec(al, bl, depth - 1); },
+             [&] { r = intersectRec(ar, br, depth - 1); });
+        if (match) {
+            this->destroy_node(match);
+            return joinNodes(l, a, r);
+        }
+        this->destroy_node(a);
+        return join2(l, r);
+    }
+    Node* differenceRec(Node* a, Node* b, int depth) {
+        if (!a || !b) {
+            this->clear(b);
+            return a;
+        }
+        Node *al, *match, *ar, *l, *r;
+        splitNode(a, b->data, al, match, ar);
+        if (match) this->destroy_node(match);
+        Node *bl = b->left, *br = b->right;
+        fork(depth, size(al) + size(ar) + size(b),
+             [&] { l = differenceRec(al, bl, depth - 1); },
+             [&] { r = differenceRec(ar, br, depth - 1); });
+        this->destroy_node(b);
+        return join2(l, r);
+    }
+
+    template<typename Make>
+    bool insertWith(const T& value, Make make) {
+        Node** path[kMaxHeight];
+        int depth = 0;
+        Node** link = &this->root;
+        while (*link) {
+            Node* node = *link;
+            path[depth++] = link;
+            if (value < node->data) link = &node->left;
+            else if (node->data < value) link = &node->right;
+            else return false; // no duplicates
+        }
+        *link = make();
+        retrace(path, depth);
+        return true;
+    }
+    // Rebalance every node on the recorded path, deepest first
+    void retrace(Node** path[], int depth) {
+        while (depth-- > 0) *path[depth] = rebalance(*path[depth]);
+    }
+    static int height(const Node* node) { return node ? node->height : 0; }
+    static size_t size(const Node* node) { return node ? node->size : 0; }
+    static void update(Node* node) {
+        node->height = 1 + std::max(height(node->left), height(node->right));
+        node->size = 1 + size(node->left) + size(node->right);
+        node->augment();
+    }
+    static int balanceFactor(const Node* node) {
         return node ? height(node->left) - height(node->right) : 0;
     }
-    Node* rightRotate(Node* y) {
+    static Node* rightRotate(Node* y) {
         Node* x = y->left;
-        Node* T2 = x->right;
+        y->left = x->right;
         x->right = y;
-        y->left = T2;
+        update(y);
+        update(x);
         return x;
     }
-    Node* leftRotate(Node* x) {
+    static Node* leftRotate(Node* x) {
         Node* y = x->right;
-        Node* T2 = y->left;
+        x->right = y->left;
         y->left = x;
-        x->right = T2;
+        update(x);
+        update(y);
         return y;
     }
-    Node* insertRec(Node* node, const T& value) {
-        if (!node) return new Node(value);
-        if (value < node->data)
-            node->left = insertRec(node->left, value);
-        else if (value > node->data)
-            node->right = insertRec(node->right, value);
-        else
-            return node; // no duplicates
+    static Node* rebalance(Node* node) {
+        update(node);
         int bf = balanceFactor(node);
-        // Left Left
-        if (bf > 1 && value < node->left->data)
+        if (bf > 1) {
+            // Left Right
+            if (balanceFactor(node->left) < 0) node->left = leftRotate(node->left);
+            // Left Left
             return rightRotate(node);
-        // Right Right
-        if (bf < -1 && value > node->right->data)
-            return leftRotate(node);
-        // Left Right
-        if (bf > 1 && value > node->left->data) {
-            node->left = leftRotate(node->left);
-            return rightRotate(node);
-        }
-        // Right Left
-        if (bf < -1 && value < node->right->data) {
-            node->right = rightRotate(node->right);
-            return leftRotate(node);
         }
-        return node;
-    }
-    Node* minValueNode(Node* node) {
-        Node* current = node;
-        while (current && current->left)
-            current = current->left;
-        return current;
-    }
-    Node* removeRec(Node* node, const T& value) {
-        if (!node) return node;
-        if (value < node->data)
-            node->left = removeRec(node->left, value);
-        else if (value > node->data)
-            node->right = removeRec(node->right, value);
-        else {
-            if (!node->left || !node->right) {
-                Node* temp = node->left ? node->left : node->right;
-                if (!temp) {
-                    temp = node;
-                    node = nullptr;
-                } else {
-                    *node = *temp;
-                }
-                delete temp;
-            } else {
-                Node* temp = minValueNode(node->right);
-                node->data = temp->data;
-                node->right = removeRec(node->right, temp->data);
-            }
-        }
-        if (!node) return node;
-        int bf = balanceFactor(node);
-        // Left Left
-        if (bf > 1 && balanceFactor(node->left) >= 0)
-            return rightRotate(node);
-        // Left Right
-        if (bf > 1 && balanceFactor(node->left) < 0) {
-            node->left = leftRotate(node->left);
-            return rightRotate(node);
-        }
-        // Right Right
-        if (bf < -1 && balanceFactor(node->right) <= 0)
-            return leftRotate(node);
-        // Right Left
-        if (bf < -1 && balanceFactor(node->right) > 0) {
-            node->right = rightRotate(node->right);
+        if (bf < -1) {
+            // Right Left
+            if (balanceFactor(node->right) > 0) node->right = rightRotate(node->right);
+            // Right Right
             return leftRotate(node);
         }
         return node;
     }
-}; 
\ No newline at end of file
+};
\ No newline at end of file
@@ -0,0 +1,413 @@
+#pragma once
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Template-based B+-tree ordered map
+// Nodes are NodeBytes wide (default 256 = four cache lines; use 4096 for
+// page-sized nodes), leaves are linked for range scans, and inner nodes are
+// searched with a branchless count the compiler vectorizes for arithmetic
+// keys. With Concurrent = true every node carries a version lock and all
+// operations use optimistic lock coupling: readers never write shared memory,
+// writers lock at most a parent/child pair. Keys and values must then be
+// trivially copyable.
+// Inner nodes split eagerly on the way down, so splits never propagate up.
+// erase does not merge underfull nodes (nodes are never freed before the
+// tree is destroyed, which is what makes optimistic reads safe); bulk_load
+// rebuilds a compact tree.
+template<typename K, typename V, bool Concurrent = false, size_t NodeBytes = 256>
+class BPlusTree {
+    static_assert(!Concurrent || (std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value),
+                  "concurrent BPlusTree needs trivially copyable keys and values");
+
+    // Version word: bit 0 = obsolete, bit 1 = locked, upper bits = version
+    struct OptimisticLock {
+        std::atomic<uint64_t> word{0b100};
+        uint64_t read_lock(bool& restart) const {
+            uint64_t v = word.load(std::memory_order_acquire);
+            if (v & 0b11) {
+                std::this_thread::yield();
+                restart = true;
+            }
+            return v;
+        }
+        void validate(uint64_t v, bool& restart) const {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (v != word.load(std::memory_order_relaxed)) restart = true;
+        }
+        void upgrade(uint64_t& v, bool& restart) {
+            if (word.compare_exchange_strong(v, v + 0b10, std::memory_order_acquire)) v += 0b10;
+            else restart = true;
+        }
+        void write_unlock() { word.fetch_add(0b10, std::memory_order_release); }
+    };
+    struct NoLock {
+        uint64_t read_lock(bool&) const { return 0; }
+        void validate(uint64_t, bool&) const {}
+        void upgrade(uint64_t&, bool&) {}
+        void write_unlock() {}
+    };
+    using Lock = std::conditional_t<Concurrent, OptimisticLock, NoLock>;
+
+    struct NodeBase {
+        Lock lock;
+        uint16_t count = 0;
+        bool leaf;
+        explicit NodeBase(bool is_leaf) : leaf(is_leaf) {}
+    };
+    static constexpr size_t kHeader = sizeof(NodeBase) + sizeof(void*);
+    static constexpr size_t fit(size_t slot) {
+        return NodeBytes > kHeader + 4 * slot ? (NodeBytes - kHeader) / slot : 4;
+    }
+public:
+    static constexpr size_t kInnerCapacity = fit(sizeof(K) + sizeof(void*));
+    static constexpr size_t kLeafCapacity = fit(sizeof(K) + sizeof(V));
+private:
+    // Number of keys < k among keys[0, count)
+    static size_t lower_bound(const K* keys, size_t count, const K& k) {
+        if constexpr (std::is_arithmetic<K>::value) {
+            size_t pos = 0;
+            for (size_t i = 0; i < count; ++i) pos += keys[i] < k;
+            return pos;
+        } else {
+            return std::lower_bound(keys, keys + count, k) - keys;
+        }
+    }
+
+    // Nodes start on a cache line; the small header shares it with keys
+    struct alignas(64) Inner : NodeBase {
+        K keys[kInnerCapacity];
+        // Zeroed: optimistic readers may load a slot before validating
+        NodeBase* children[kInnerCapacity + 1] = {};
+        Inner() : NodeBase(false) {}
+        bool full() const { return this->count == kInnerCapacity; }
+        size_t find(const K& k) const { return lower_bound(keys, this->count, k); }
+        // Keys of children[i] are <= keys[i] and > keys[i - 1]
+        void insert(const K& sep, NodeBase* right) {
+            size_t pos = find(sep);
+            std::move_backward(keys + pos, keys + this->count, keys + this->count + 1);
+            std::move_backward(children + pos + 1, children + this->count + 1, children + this->count + 2);
+            keys[pos] = sep;
+            children[pos + 1] = right;
+            ++this->count;
+        }
+        Inner* split(K& sep) {
+            Inner* right = new Inner();
+            size_t mid = this->count / 2;
+            right->count = static_cast<uint16_t>(this->count - mid - 1);
+            std::copy(keys + mid + 1, keys + this->count, right->keys);
+            std::copy(children + mid + 1, children + this->count + 1, right->children);
+            sep = keys[mid];
+            this->count = static_cast<uint16_t>(mid);
+            return right;
+        }
+    };
+
+    struct alignas(64) Leaf : NodeBase {
+        K keys[kLeafCapacity];
+        V values[kLeafCapacity];
+        Leaf* next = nullptr;
+        Leaf() : NodeBase(true) {}
+        bool full() const { return this->count == kLeafCapacity; }
+        size_t find(const K& k) const { return lower_bound(keys, this->count, k); }
+        Leaf* split(K& sep) {
+            Leaf* right = new Leaf();
+            size_t mid = this->count / 2;
+            right->count = static_cast<uint16_t>(this->count - mid);
+            std::move(keys + mid, keys + this->count, right->keys);
+            std::move(values + mid, values + this->count, right->values);
+            this->count = static_cast<uint16_t>(mid);
+            sep = keys[mid - 1];
+            right->next = next;
+            next = right;
+            return right;
+        }
+    };
+
+    std::atomic<NodeBase*> root;
+    std::atomic<size_t> count{0};
+
+public:
+    BPlusTree() : root(new Leaf()) {}
+    ~BPlusTree() { destroy(root.load()); }
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+
+    // Returns false (and keeps the old value) if k is already present
+    bool insert(const K& k, const V& v) { return insertImpl(k, v, false); }
+    // Returns true if k was newly inserted
+    bool insert_or_assign(const K& k, const V& v) { return insertImpl(k, v, true); }
+
+    std::optional<V> find(const K& k) const {
+        while (true) {
+            bool restart = false;
+            uint64_t version;
+            const Leaf* leaf = findLeaf(k, version, restart);
+            if (restart) continue;
+            size_t pos = leaf->find(k);
+            std::optional<V> result;
+            if (pos < leaf->count && !(k < leaf->keys[pos])) result = leaf->values[pos];
+            leaf->lock.validate(version, restart);
+            if (!restart) return result;
+        }
+    }
+    bool contains(const K& k) const { return find(k).has_value(); }
+
+    bool erase(const K& k) {
+        while (true) {
+            bool restart = false;
+            uint64_t version;
+            Leaf* leaf = const_cast<Leaf*>(findLeaf(k, version, restart));
+            if (restart) continue;
+            leaf->lock.upgrade(version, restart);
+            if (restart) continue;
+            size_t pos = leaf->find(k);
+            bool found = pos < leaf->count && !(k < leaf->keys[pos]);
+            if (found) {
+                std::move(leaf->keys + pos + 1, leaf->keys + leaf->count, leaf->keys + pos);
+                std::move(leaf->values + pos + 1, leaf->values + leaf->count, leaf->values + pos);
+                --leaf->count;
+                count.fetch_sub(1, std::memory_order_relaxed);
+            }
+            leaf->lock.write_unlock();
+            return found;
+        }
+    }
+
+    // Calls f(key, value) for every key in [lo, hi), in order, walking the
+    // linked leaves. In concurrent mode each leaf is copied out and validated
+    // before f sees it.
+    template<typename F>
+    void scan(const K& lo, const K& hi, F f) const {
+        K from = lo;
+        bool inclusive = true;
+        while (true) {
+            bool restart = false;
+            uint64_t version;
+            const Leaf* leaf = findLeaf(from, version, restart);
+            if (restart) continue;
+            while (leaf) {
+                size_t pos = leaf->find(from);
+                if (!inclusive && pos < leaf->count && !(from < leaf->keys[pos])) ++pos;
+                if constexpr (Concurrent) {
+                    K keys[kLeafCapacity];
+                    V values[kLeafCapacity];
+                    size_t n = 0;
+                    bool done = false;
+                    for (size_t end = leaf->count; pos < end && pos < kLeafCapacity; ++pos, ++n) {
+                        if (!(leaf->keys[pos] < hi)) { done = true; break; }
+                        keys[n] = leaf->keys[pos];
+                        values[n] = leaf->values[pos];
+                    }
+                    const Leaf* next = leaf->next;
+                    leaf->lock.validate(version, restart);
+                    if (restart) break;
+                    for (size_t i = 0; i < n; ++i) f(keys[i], values[i]);
+                    if (n > 0) { from = keys[n - 1]; inclusive = false; }
+                    if (done || !next) return;
+                    version = next->lock.read_lock(restart);
+                    if (restart) break;
+                    leaf = next;
+                } else {
+                    for (; pos < leaf->count; ++pos) {
+                        if (!(leaf->keys[pos] < hi)) return;
+                        f(leaf->keys[pos], leaf->values[pos]);
+                    }
+                    leaf = leaf->next;
+                }
+            }
+            if (!restart) return;
+        }
+    }
+
+    // Replaces the contents with sorted, unique (key, value) pairs in O(n);
+    // nodes are packed full. Not thread-safe.
+    template<typename It>
+    void bulk_load(It first, It last) {
+        destroy(root.load());
+        std::vector<std::pair<NodeBase*, K>> level; // node and its max key
+        std::vector<std::pair<K, V>> items(first, last);
+        size_t n = items.size();
+        count.store(n, std::memory_order_relaxed);
+        if (n == 0) { root.store(new Leaf()); return; }
+        size_t leaves = (n + kLeafCapacity - 1) / kLeafCapacity;
+        Leaf* prev = nullptr;
+        for (size_t i = 0, begin = 0; i < leaves; ++i) {
+            size_t end = n * (i + 1) / leaves;
+            Leaf* leaf = new Leaf();
+            for (size_t j = begin; j < end; ++j) {
+                leaf->keys[j - begin] = std::move(items[j].first);
+                leaf->values[j - begin] = std::move(items[j].second);
+            }
+            leaf->count = static_cast<uint16_t>(end - begin);
+            if (prev) prev->next = leaf;
+            prev = leaf;
+            level.emplace_back(leaf, leaf->keys[leaf->count - 1]);
+            begin = end;
+        }
+        while (level.size() > 1) {
+            size_t m = level.size(), nodes = (m + kInnerCapacity) / (kInnerCapacity + 1);
+            std::vector<std::pair<NodeBase*, K>> up;
+            for (size_t i = 0, begin = 0; i < nodes; ++i) {
+                size_t end = m * (i + 1) / nodes;
+                Inner* inner = new Inner();
+                for (size_t j = begin; j < end; ++j) {
+                    inner->children[j - begin] = level[j].first;
+                    if (j + 1 < end) inner->keys[j - begin] = level[j].second;
+                }
+                inner->count = static_cast<uint16_t>(end - begin - 1);
+                up.emplace_back(inner, level[end - 1].second);
+                begin = end;
+            }
+            level.swap(up);
+        }
+        root.store(level.front().first);
+    }
+
+    void clear() {
+        destroy(root.load());
+        root.store(new Leaf());
+        count.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    // Optimistic descent to the leaf that may contain k; on success the
+    // leaf's version is returned for later validation
+    const Leaf* findLeaf(const K& k, uint64_t& version, bool& restart) const {
+        NodeBase* node = root.load(std::memory_order_acquire);
+        version = node->lock.read_lock(restart);
+        if (restart || node != root.load(std::memory_order_acquire)) {
+            restart = true;
+            return nullptr;
+        }
+        while (!node->leaf) {
+            const Inner* inner = static_cast<const Inner*>(node);
+            size_t pos = std::min<size_t>(inner->find(k), kInnerCapacity);
+            node = inner->children[pos];
+            uint64_t parentVersion = version;
+            version = node->lock.read_lock(restart);
+            if (restart) return nullptr;
+            // The parent must still be unchanged once the child is pinned,
+            // otherwise the child may have split under us
+            inner->lock.validate(parentVersion, restart);
+            if (restart) return nullptr;
+        }
+        return static_cast<const Leaf*>(node);
+    }
+
+    void makeRoot(const K& sep, NodeBase* left, NodeBase* right) {
+        Inner* inner = new Inner();
+        inner->count = 1;
+        inner->keys[0] = sep;
+        inner->children[0] = left;
+        inner->children[1] = right;
+        root.store(inner, std::memory_order_release);
+    }
+
+    // Locks parent (if any) and node for a split; false means restart
+    bool lockForSplit(Inner* parent, uint64_t& parentVersion, NodeBase* node, uint64_t& version) {
+        bool restart = false;
+        if (parent) {
+            parent->lock.upgrade(parentVersion, restart);
+            if (restart) return false;
+        }
+        node->lock.upgrade(version, restart);
+        if (restart) {
+            if (parent) parent->lock.write_unlock();
+            return false;
+        }
+        if (!parent && node != root.load(std::memory_order_relaxed)) {
+            node->lock.write_unlock();
+            return false;
+        }
+        return true;
+    }
+
+    bool insertImpl(const K& k, const V& v, bool assign) {
+        while (true) {
+            bool restart = false;
+            NodeBase* node = root.load(std::memory_order_acquire);
+            uint64_t version = node->lock.read_lock(restart);
+            if (restart || node != root.load(std::memory_order_acquire)) continue;
+            Inner* parent = nullptr;
+            uint64_t parentVersion = 0;
+
+            while (!node->leaf) {
+                Inner* inner = static_cast<Inner*>(node);
+                if (inner->full()) {
+                    if (!lockForSplit(parent, parentVersion, inner, version)) { restart = true; break; }
+                    K sep;
+                    Inner* right = inner->split(sep);
+                    if (parent) parent->insert(sep, right);
+                    else makeRoot(sep, inner, right);
+                    inner->lock.write_unlock();
+                    if (parent) parent->lock.write_unlock();
+                    restart = true;
+                    break;
+                }
+                if (parent) {
+                    parent->lock.validate(parentVersion, restart);
+                    if (restart) break;
+                }
+                parent = inner;
+                parentVersion = version;
+                node = inner->children[std::min<size_t>(inner->find(k), kInnerCapacity)];
+                inner->lock.validate(version, restart);
+                if (restart) break;
+                version = node->lock.read_lock(restart);
+                if (restart) break;
+            }
+            if (restart) continue;
+
+            Leaf* leaf = static_cast<Leaf*>(node);
+            if (leaf->full()) {
+                if (!lockForSplit(parent, parentVersion, leaf, version)) continue;
+                K sep;
+                Leaf* right = leaf->split(sep);
+                if (parent) parent->insert(sep, right);
+                else makeRoot(sep, leaf, right);
+                leaf->lock.write_unlock();
+                if (parent) parent->lock.write_unlock();
+                continue;
+            }
+            leaf->lock.upgrade(version, restart);
+            if (restart) continue;
+            if (parent) {
+                parent->lock.validate(parentVersion, restart);
+                if (restart) { leaf->lock.write_unlock(); continue; }
+            }
+            size_t pos = leaf->find(k);
+            bool exists = pos < leaf->count && !(k < leaf->keys[pos]);
+            if (exists) {
+                if (assign) leaf->values[pos] = v;
+            } else {
+                std::move_backward(leaf->keys + pos, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+                std::move_backward(leaf->values + pos, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+                leaf->keys[pos] = k;
+                leaf->values[pos] = v;
+                ++leaf->count;
+                count.fetch_add(1, std::memory_order_relaxed);
+            }
+            leaf->lock.write_unlock();
+            return !exists;
+        }
+    }
+
+    static void destroy(NodeBase* node) {
+        if (!node) return;
+        if (node->leaf) { delete static_cast<Leaf*>(node); return; }
+        Inner* inner = static_cast<Inner*>(node);
+        for (size_t i = 0; i <= inner->count; ++i) destroy(inner->children[i]);
+        delete inner;
+    }
+};
\ No newline at end of file
@@ -4,13 +4,15 @@
 #include <functional>
 
 // Template-based BinaryTree as a child of Tree<T>
-template<typename T>
-class BinaryTree : public Tree<T> {
-    using Node = typename Tree<T>::Node;
+template<typename T, typename Alloc = std::allocator<TreeNode<T>>>
+class BinaryTree : public Tree<T, TreeNode<T>, Alloc> {
+    using Node = TreeNode<T>;
 public:
+    using Tree<T, TreeNode<T>, Alloc>::Tree;
+
     // Insert as a binary tree (not BST): fill level order
     void insert(const T& value) {
-        Node* newNode = new Node(value);
+        Node* newNode = this->create_node(value);
         if (!this->root) {
             this->root = newNode;
             return;
@@ -44,7 +46,7 @@ private:
         removeHelper(node->left, value);
         removeHelper(node->right, value);
         if (node->data == value) {
-            delete node;
+            this->clear(node);
             node = nullptr;
         }
     }
@@ -0,0 +1,147 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+// Template-based implicit complete binary tree stored in level order
+// Children of slot i are 2i + 1 and 2i + 2, so insert is an O(1) append and
+// traversals walk the array by index arithmetic with O(1) extra memory.
+// remove only marks slots as erased; compact() drops them in one O(n) pass.
+// Offers the same traversal API as Tree<T>.
+template<typename T>
+class CompleteBinaryTree {
+    std::vector<T> data;
+    std::vector<bool> erased;
+    size_t live = 0;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+public:
+    CompleteBinaryTree() = default;
+    template<typename It>
+    CompleteBinaryTree(It first, It last) : data(first, last), erased(data.size(), false), live(data.size()) {}
+
+    void insert(const T& value) { emplace(value); }
+    void insert(T&& value) { emplace(std::move(value)); }
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        data.emplace_back(std::forward<Args>(args)...);
+        erased.push_back(false);
+        ++live;
+    }
+    void reserve(size_t n) {
+        data.reserve(n);
+        erased.reserve(n);
+    }
+
+    // Marks all nodes with a given value as erased; returns how many
+    size_t remove(const T& value) {
+        size_t removed = 0;
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (!erased[i] && data[i] == value) {
+                erased[i] = true;
+                ++removed;
+            }
+        }
+        live -= removed;
+        return removed;
+    }
+    // Drops erased slots, keeping the level order of the rest
+    void compact() {
+        size_t out = 0;
+        for (size_t i = 0; i < data.size(); ++i)
+            if (!erased[i]) {
+                if (out != i) data[out] = std::move(data[i]);
+                ++out;
+            }
+        data.erase(data.begin() + out, data.end());
+        erased.assign(out, false);
+    }
+    void clear() {
+        data.clear();
+        erased.clear();
+        live = 0;
+    }
+
+    size_t size() const { return live; }
+    bool empty() const { return live == 0; }
+    // Slot access in level order, including erased slots until compact()
+    size_t slots() const { return data.size(); }
+    const T& operator[](size_t i) const { return data[i]; }
+    bool is_erased(size_t i) const { return erased[i]; }
+
+    // Utility: Inorder traversal
+    void inorder(std::function<void(const T&)> visit) const {
+        if (data.empty()) return;
+        for (size_t i = descend(0, true); i != npos; i = nextInorder(i, true)) emit(i, visit);
+    }
+    // Utility: Preorder traversal
+    void preorder(std::function<void(const T&)> visit) const {
+        for (size_t i = data.empty() ? npos : 0; i != npos; i = nextPreorder(i, true)) emit(i, visit);
+    }
+    // Utility: Postorder traversal
+    void postorder(std::function<void(const T&)> visit) const {
+        if (data.empty()) return;
+        for (size_t i = firstPostorder(0, true); i != npos; i = nextPostorder(i, true)) emit(i, visit);
+    }
+    // Utility: Reverse inorder traversal
+    void reverse_inorder(std::function<void(const T&)> visit) const {
+        if (data.empty()) return;
+        for (size_t i = descend(0, false); i != npos; i = nextInorder(i, false)) emit(i, visit);
+    }
+    // Utility: Reverse preorder traversal
+    void reverse_preorder(std::function<void(const T&)> visit) const {
+        for (size_t i = data.empty() ? npos : 0; i != npos; i = nextPreorder(i, false)) emit(i, visit);
+    }
+    // Utility: Reverse postorder traversal
+    void reverse_postorder(std::function<void(const T&)> visit) const {
+        if (data.empty()) return;
+        for (size_t i = firstPostorder(0, false); i != npos; i = nextPostorder(i, false)) emit(i, visit);
+    }
+
+    // Utility: Level-order traversal, a plain array scan
+    void level_order(std::function<void(const T&)> visit) const {
+        for (size_t i = 0; i < data.size(); ++i) emit(i, visit);
+    }
+
+private:
+    // "first" child is the left one in forward traversals, the right one in
+    // reverse traversals
+    static size_t parent(size_t i) { return (i - 1) / 2; }
+    static size_t firstChild(size_t i, bool forward) { return 2 * i + (forward ? 1 : 2); }
+    static size_t secondChild(size_t i, bool forward) { return 2 * i + (forward ? 2 : 1); }
+    static bool isFirstChild(size_t i, bool forward) { return (i % 2 == 1) == forward; }
+    static size_t sibling(size_t i) { return i % 2 ? i + 1 : i - 1; }
+    bool has(size_t i) const { return i < data.size(); }
+
+    void emit(size_t i, const std::function<void(const T&)>& visit) const {
+        if (!erased[i]) visit(data[i]);
+    }
+    size_t descend(size_t i, bool forward) const {
+        while (has(firstChild(i, forward))) i = firstChild(i, forward);
+        return i;
+    }
+    size_t nextInorder(size_t i, bool forward) const {
+        if (has(secondChild(i, forward))) return descend(secondChild(i, forward), forward);
+        while (i > 0 && !isFirstChild(i, forward)) i = parent(i);
+        return i == 0 ? npos : parent(i);
+    }
+    size_t nextPreorder(size_t i, bool forward) const {
+        if (has(firstChild(i, forward))) return firstChild(i, forward);
+        if (has(secondChild(i, forward))) return secondChild(i, forward);
+        for (; i > 0; i = parent(i))
+            if (isFirstChild(i, forward) && has(sibling(i))) return sibling(i);
+        return npos;
+    }
+    size_t firstPostorder(size_t i, bool forward) const {
+        while (true) {
+            if (has(firstChild(i, forward))) i = firstChild(i, forward);
+            else if (has(secondChild(i, forward))) i = secondChild(i, forward);
+            else return i;
+        }
+    }
+    size_t nextPostorder(size_t i, bool forward) const {
+        if (i == 0) return npos;
+        if (isFirstChild(i, forward) && has(sibling(i))) return firstPostorder(sibling(i), forward);
+        return parent(i);
+    }
+};
\ No newline at end of file
@@ -0,0 +1,187 @@
+#pragma once
+#include "LazySegmentTree.hpp"
+#include "SegmentTree.hpp"
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+// Template-based dynamic (sparse) lazy segment tree over the key range
+// [lo, hi) of 64-bit coordinates, e.g. timestamps or hashes up to 2^63.
+// Takes the same Action policies as LazySegmentTree. Nodes are created only
+// when an update reaches them, so memory is O(log U) per update for a key
+// range of size U; queries never allocate. Nodes live in one vector with
+// 32-bit child indices, where index 0 means "untouched, aggregate Init".
+// Recursion depth is bounded by 64. Ranges are [l, r).
+template<typename Action, typename Init = DefaultInit<Action>>
+class DynamicSegmentTree {
+public:
+    using S = typename Action::S;
+    using F = typename Action::F;
+
+private:
+    struct Node {
+        S value;
+        F lazy;
+        uint32_t left;
+        uint32_t right;
+    };
+    std::vector<Node> nodes;
+    int64_t lo, hi;
+    Init init;
+    static constexpr uint32_t kRoot = 1;
+
+public:
+    explicit DynamicSegmentTree(int64_t lo_key = 0, int64_t hi_key = std::numeric_limits<int64_t>::max(),
+                                Init init_func = Init())
+        : lo(lo_key), hi(hi_key), init(init_func) {
+        if (lo >= hi) throw std::invalid_argument("DynamicSegmentTree key range is empty");
+        clear();
+    }
+
+    void set(int64_t p, const S& x) {
+        checkKey(p);
+        setAt(kRoot, lo, hi, p, x);
+    }
+    S get(int64_t p) const {
+        checkKey(p);
+        return query(p, p + 1);
+    }
+    S query(int64_t l, int64_t r) const {
+        checkRange(l, r);
+        if (l >= r) return Action::e();
+        return queryAt(kRoot, lo, hi, l, r, Action::id());
+    }
+    const S& all() const { return nodes[kRoot].value; }
+
+    void apply(int64_t p, const F& f) {
+        checkKey(p);
+        applyAt(kRoot, lo, hi, p, p + 1, f);
+    }
+    void apply(int64_t l, int64_t r, const F& f) {
+        checkRange(l, r);
+        if (l < r) applyAt(kRoot, lo, hi, l, r, f);
+    }
+
+    // Drops every update; keeps the allocated capacity
+    void clear() {
+        nodes.clear();
+        nodes.push_back({Action::e(), Action::id(), 0, 0});
+        nodes.push_back({init(lo, hi), Action::id(), 0, 0});
+    }
+    void reserve(size_t count) { nodes.reserve(count); }
+    size_t node_count() const { return nodes.size() - 1; }
+
+private:
+    // Midpoint without overflow, even for a range spanning all of int64_t
+    static int64_t middle(int64_t l, int64_t r) {
+        return l + static_cast<int64_t>((static_cast<uint64_t>(r) - static_cast<uint64_t>(l)) / 2);
+    }
+    void checkKey(int64_t p) const {
+        if (p < lo || p >= hi) throw std::out_of_range("DynamicSegmentTree key out of range");
+    }
+    void checkRange(int64_t l, int64_t r) const {
+        if (l < lo || r > hi) throw std::out_of_range("DynamicSegmentTree range out of bounds");
+    }
+    uint32_t newNode(int64_t l, int64_t r) {
+        if (nodes.size() > std::numeric_limits<uint32_t>::max())
+            throw std::length_error("DynamicSegmentTree node index exceeds 32 bits");
+        nodes.push_back({init(l, r), Action::id(), 0, 0});
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+    void applyAll(uint32_t k, const F& f) {
+        nodes[k].value = Action::mapping(f, nodes[k].value);
+        nodes[k].lazy = Action::composition(f, nodes[k].lazy);
+    }
+    // Materializes both children and hands them the pending action
+    void push(uint32_t k, int64_t l, int64_t m, int64_t r) {
+        if (!nodes[k].left) {
+            uint32_t c = newNode(l, m);
+            nodes[k].left = c;
+        }
+        if (!nodes[k].right) {
+            uint32_t c = newNode(m, r);
+            nodes[k].right = c;
+        }
+        F f = nodes[k].lazy;
+        applyAll(nodes[k].left, f);
+        applyAll(nodes[k].right, f);
+        nodes[k].lazy = Action::id();
+    }
+    void pull(uint32_t k) { nodes[k].value = Action::op(nodes[nodes[k].left].value, nodes[nodes[k].right].value); }
+
+    void setAt(uint32_t k, int64_t l, int64_t r, int64_t p, const S& x) {
+        if (l + 1 == r) {
+            nodes[k].value = x;
+            nodes[k].lazy = Action::id();
+            return;
+        }
+        int64_t m = middle(l, r);
+        push(k, l, m, r);
+        if (p < m) setAt(nodes[k].left, l, m, p, x);
+        else setAt(nodes[k].right, m, r, p, x);
+        pull(k);
+    }
+    void applyAt(uint32_t k, int64_t l, int64_t r, int64_t ql, int64_t qr, const F& f) {
+        if (ql <= l && r <= qr) {
+            applyAll(k, f);
+            return;
+        }
+        int64_t m = middle(l, r);
+        push(k, l, m, r);
+        if (ql < m) applyAt(nodes[k].left, l, m, ql, qr, f);
+        if (m < qr) applyAt(nodes[k].right, m, r, ql, qr, f);
+        pull(k);
+    }
+    // pending is the composition of the actions stored above k; an absent
+    // node is an untouched segment with only those actions applied
+    S queryAt(uint32_t k, int64_t l, int64_t r, int64_t ql, int64_t qr, const F& pending) const {
+        if (!k) return Action::mapping(pending, init(std::max(l, ql), std::min(r, qr)));
+        if (ql <= l && r <= qr) return Action::mapping(pending, nodes[k].value);
+        int64_t m = middle(l, r);
+        F down = Action::composition(pending, nodes[k].lazy);
+        if (qr <= m) return queryAt(nodes[k].left, l, m, ql, qr, down);
+        if (m <= ql) return queryAt(nodes[k].right, m, r, ql, qr, down);
+        return Action::op(queryAt(nodes[k].left, l, m, ql, qr, down), queryAt(nodes[k].right, m, r, ql, qr, down));
+    }
+};
+
+// Offline alternative when every key is known up front: compresses the
+// keys to ranks and keeps a dense SegmentTree over them, so updates and
+// queries are O(log k) for k distinct keys with no per-node allocation.
+template<typename K, typename T, typename F = std::function<T(const T&, const T&)>>
+class CompressedSegmentTree {
+    std::vector<K> keys;
+    SegmentTree<T, F> tree;
+public:
+    CompressedSegmentTree(std::vector<K> all_keys, F merge_func, T id)
+        : keys(compress(std::move(all_keys))), tree(static_cast<int>(keys.size()), merge_func, id) {}
+    // For stateless monoids from Monoid.hpp
+    template<typename G = F, typename = decltype(G::identity())>
+    explicit CompressedSegmentTree(std::vector<K> all_keys)
+        : keys(compress(std::move(all_keys))), tree(static_cast<int>(keys.size())) {}
+
+    // Key must be one of the keys given at construction
+    void update(const K& key, T value) {
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        if (it == keys.end() || key < *it) throw std::out_of_range("CompressedSegmentTree key was not registered");
+        tree.update(static_cast<int>(it - keys.begin()), value);
+    }
+    // Combines the values of all registered keys in [lo, hi)
+    T query(const K& lo, const K& hi) const {
+        return tree.query(rank(lo), std::max(rank(lo), rank(hi)));
+    }
+    // Number of registered keys less than key
+    int rank(const K& key) const { return static_cast<int>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin()); }
+    int size() const { return static_cast<int>(keys.size()); }
+
+private:
+    static std::vector<K> compress(std::vector<K> v) {
+        std::sort(v.begin(), v.end());
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+        return v;
+    }
+};
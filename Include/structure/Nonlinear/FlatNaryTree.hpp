@@ -0,0 +1,128 @@
+#pragma once
+#include "NaryTree.hpp"
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// Template-based n-ary tree stored in preorder in parallel arrays
+// Node i's subtree occupies indices [i, i + subtree_size(i)), so whole-subtree
+// traversal is a linear scan and ancestor tests are O(1). Links are 32-bit
+// indices: with an int payload a node takes 20 bytes and no allocation of its
+// own, against two heap blocks and a child vector per NaryTree node.
+template<typename T>
+class FlatNaryTree {
+public:
+    using index_type = uint32_t;
+    static constexpr index_type npos = UINT32_MAX;
+
+    FlatNaryTree() = default;
+    explicit FlatNaryTree(const NaryTree<T>& tree) {
+        using Node = typename NaryTree<T>::Node;
+        if (!tree.root) return;
+        std::vector<index_type> parent_of;
+        std::vector<std::pair<const Node*, index_type>> stack{{tree.root.get(), npos}};
+        while (!stack.empty()) {
+            auto [node, p] = stack.back();
+            stack.pop_back();
+            index_type id = checkedIndex(values.size());
+            values.push_back(node->data);
+            parent_of.push_back(p);
+            for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+                stack.emplace_back(it->get(), id);
+        }
+        link(std::move(parent_of));
+    }
+    // Builds from values listed in preorder and each one's parent index
+    // (npos for the root, which must come first). Throws
+    // std::invalid_argument if the order is not a preorder of the tree.
+    FlatNaryTree(std::vector<T> data, std::vector<index_type> parent_of) : values(std::move(data)) {
+        if (values.size() != parent_of.size())
+            throw std::invalid_argument("FlatNaryTree needs one parent per value");
+        checkedIndex(values.size());
+        // Each node's parent must lie on the path from the root to the
+        // previous node
+        std::vector<index_type> path;
+        for (size_t i = 0; i < parent_of.size(); ++i) {
+            if (i == 0) {
+                if (parent_of[0] != npos) throw std::invalid_argument("FlatNaryTree root must come first");
+            } else {
+                while (!path.empty() && path.back() != parent_of[i]) path.pop_back();
+                if (path.empty()) throw std::invalid_argument("FlatNaryTree input is not in preorder");
+            }
+            path.push_back(static_cast<index_type>(i));
+        }
+        link(std::move(parent_of));
+    }
+
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    index_type root() const { return values.empty() ? npos : 0; }
+
+    const T& operator[](index_type i) const { return values[i]; }
+    T& operator[](index_type i) { return values[i]; }
+    index_type parent(index_type i) const { return parents[i]; }
+    index_type first_child(index_type i) const { return firstChild[i]; }
+    index_type next_sibling(index_type i) const { return nextSibling[i]; }
+    // O(1): the subtree is the preorder range [i, i + subtree_size(i))
+    index_type subtree_size(index_type i) const { return sizes[i]; }
+    std::pair<index_type, index_type> subtree_range(index_type i) const { return {i, i + sizes[i]}; }
+    bool is_ancestor(index_type u, index_type v) const { return u <= v && v < u + sizes[u]; }
+    // Values in preorder
+    const std::vector<T>& data() const { return values; }
+
+    template<typename F>
+    void for_each_child(index_type i, F f) const {
+        for (index_type c = firstChild[i]; c != npos; c = nextSibling[c]) f(c);
+    }
+
+    // Preorder traversal
+    void traverse(std::function<void(const T&)> visit) const {
+        for (const T& value : values) visit(value);
+    }
+    void traverse(index_type i, std::function<void(const T&)> visit) const {
+        for (index_type end = i + sizes[i]; i < end; ++i) visit(values[i]);
+    }
+    // Reverse preorder traversal (children right to left)
+    void reverse_traverse(std::function<void(const T&)> visit) const {
+        if (!values.empty()) reverse_traverse(0, visit);
+    }
+    void reverse_traverse(index_type i, std::function<void(const T&)> visit) const {
+        // Children are pushed left to right, so they pop right to left
+        std::vector<index_type> stack{i};
+        while (!stack.empty()) {
+            index_type node = stack.back();
+            stack.pop_back();
+            visit(values[node]);
+            for_each_child(node, [&](index_type c) { stack.push_back(c); });
+        }
+    }
+
+private:
+    std::vector<T> values;
+    std::vector<index_type> parents, firstChild, nextSibling, sizes;
+
+    static index_type checkedIndex(size_t n) {
+        if (n >= npos) throw std::length_error("FlatNaryTree holds at most 2^32 - 1 nodes");
+        return static_cast<index_type>(n);
+    }
+    // Derives sizes and child links from the parent array in two O(n) scans
+    void link(std::vector<index_type> parentOf) {
+        size_t n = parentOf.size();
+        parents = std::move(parentOf);
+        sizes.assign(n, 1);
+        for (size_t i = n; i-- > 1;) sizes[parents[i]] += sizes[i];
+        firstChild.assign(n, npos);
+        nextSibling.assign(n, npos);
+        for (size_t i = 0; i < n; ++i) {
+            if (sizes[i] > 1) firstChild[i] = static_cast<index_type>(i + 1);
+            // The next sibling starts right after this subtree, if that is
+            // still inside the parent's subtree
+            size_t next = i + sizes[i];
+            if (i > 0 && next < size_t(parents[i]) + sizes[parents[i]])
+                nextSibling[i] = static_cast<index_type>(next);
+        }
+    }
+};
@@ -2,50 +2,157 @@
 #include <vector>
 #include <functional>
 #include <stdexcept>
+#include <utility>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <cstddef>
 
-// Template-based binary heap (min-heap by default)
-template<typename T, typename Compare = std::less<T>>
+// Allocator that places element 0 Offset bytes past a cache-line boundary.
+// With Offset = (d - 1) * sizeof(T), the children d*i + 1 .. d*i + d of
+// every d-ary heap node start on a multiple of d * sizeof(T), so a child
+// group never straddles a line when d * sizeof(T) divides 64.
+template<typename U, size_t Offset>
+class CacheOffsetAllocator {
+public:
+    using value_type = U;
+    static constexpr size_t kLine = 64;
+    template<typename V>
+    struct rebind { using other = CacheOffsetAllocator<V, Offset>; };
+
+    CacheOffsetAllocator() = default;
+    template<typename V>
+    CacheOffsetAllocator(const CacheOffsetAllocator<V, Offset>&) {}
+
+    U* allocate(size_t n) {
+        char* raw = static_cast<char*>(::operator new(n * sizeof(U) + Offset, std::align_val_t(kLine)));
+        return reinterpret_cast<U*>(raw + Offset);
+    }
+    void deallocate(U* p, size_t) {
+        ::operator delete(reinterpret_cast<char*>(p) - Offset, std::align_val_t(kLine));
+    }
+    template<typename V>
+    bool operator==(const CacheOffsetAllocator<V, Offset>&) const { return true; }
+    template<typename V>
+    bool operator!=(const CacheOffsetAllocator<V, Offset>&) const { return false; }
+};
+
+// Template-based d-ary heap (binary min-heap by default)
+// Sifts move a hole instead of swapping, so each level costs one move.
+// Wider heaps (Arity 4 or 8) are two or three times shallower and read each
+// child group from a single cache line; pops compare more children per
+// level, so they pay off for large heaps of small keys.
+template<typename T, typename Compare = std::less<T>, size_t Arity = 2>
 class Heap {
-    std::vector<T> data;
+    static_assert(Arity >= 2, "Heap arity must be at least 2");
+    static constexpr size_t kGroupBytes = Arity * sizeof(T);
+    static constexpr bool kAlignGroups = Arity > 2 && kGroupBytes <= 64 && 64 % kGroupBytes == 0;
+    using Storage = std::conditional_t<kAlignGroups,
+                                       std::vector<T, CacheOffsetAllocator<T, (Arity - 1) * sizeof(T)>>,
+                                       std::vector<T>>;
+    Storage data;
     Compare comp;
 public:
     Heap() = default;
     explicit Heap(Compare cmp) : comp(cmp) {}
+    // Heapifies [first, last) bottom-up in O(n)
+    template<typename It>
+    Heap(It first, It last, Compare cmp = Compare()) : data(first, last), comp(cmp) { heapify(); }
 
-    void push(const T& value) {
-        data.push_back(value);
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        data.emplace_back(std::forward<Args>(args)...);
         sift_up(data.size() - 1);
     }
-    void pop() {
+    void pop() { pop_value(); }
+    // Removes the top element and returns it by move
+    T pop_value() {
         if (data.empty()) throw std::out_of_range("Heap is empty");
-        std::swap(data.front(), data.back());
+        T top = std::move(data.front());
+        T last = std::move(data.back());
         data.pop_back();
-        if (!data.empty()) sift_down(0);
+        if (!data.empty()) sift_down(0, std::move(last));
+        return top;
+    }
+    // Same as push(value) then pop_value(), in one sift
+    T push_pop(T value) {
+        if (data.empty() || !comp(data.front(), value)) return value;
+        T top = std::move(data.front());
+        sift_down(0, std::move(value));
+        return top;
+    }
+    // Same as pop_value() then push(value), in one sift
+    T replace_top(T value) {
+        if (data.empty()) throw std::out_of_range("Heap is empty");
+        T top = std::move(data.front());
+        sift_down(0, std::move(value));
+        return top;
     }
     const T& top() const {
         if (data.empty()) throw std::out_of_range("Heap is empty");
         return data.front();
     }
+    // Moves every element of other into this heap. Small heaps are pushed
+    // one by one; otherwise the arrays are concatenated and reheapified.
+    void merge(Heap&& other) {
+        if (data.size() < other.data.size()) std::swap(data, other.data);
+        size_t levels = 0;
+        for (size_t n = data.size(); n > 1; n /= Arity) ++levels;
+        if (other.data.size() * levels < data.size()) {
+            for (T& value : other.data) push(std::move(value));
+        } else {
+            data.insert(data.end(), std::make_move_iterator(other.data.begin()),
+                        std::make_move_iterator(other.data.end()));
+            heapify();
+        }
+        other.data.clear();
+    }
+    void reserve(size_t n) { data.reserve(n); }
+    // Elements in storage (heap) order, not sorted
+    auto begin() const { return data.begin(); }
+    auto end() const { return data.end(); }
     size_t size() const { return data.size(); }
     bool empty() const { return data.empty(); }
 private:
+    void heapify() {
+        if (data.size() < 2) return;
+        for (size_t i = (data.size() - 2) / Arity + 1; i-- > 0;) sift_down(i, std::move(data[i]));
+    }
     void sift_up(size_t idx) {
+        T value = std::move(data[idx]);
         while (idx > 0) {
-            size_t parent = (idx - 1) / 2;
-            if (!comp(data[idx], data[parent])) break;
-            std::swap(data[idx], data[parent]);
+            size_t parent = (idx - 1) / Arity;
+            if (!comp(value, data[parent])) break;
+            data[idx] = std::move(data[parent]);
             idx = parent;
         }
+        data[idx] = std::move(value);
     }
-    void sift_down(size_t idx) {
+    // Fills the hole at idx with value, moving smaller children up
+    void sift_down(size_t idx, T value) {
         size_t n = data.size();
-        while (2 * idx + 1 < n) {
-            size_t left = 2 * idx + 1, right = 2 * idx + 2, smallest = idx;
-            if (left < n && comp(data[left], data[smallest])) smallest = left;
-            if (right < n && comp(data[right], data[smallest])) smallest = right;
-            if (smallest == idx) break;
-            std::swap(data[idx], data[smallest]);
-            idx = smallest;
+        while (Arity * idx + 1 < n) {
+            size_t first = Arity * idx + 1;
+            size_t child = first + Arity <= n ? best_child_full(first) : best_child(first, n);
+            if (!comp(data[child], value)) break;
+            data[idx] = std::move(data[child]);
+            idx = child;
         }
+        data[idx] = std::move(value);
+    }
+    // Index of the highest-priority child. A full group has a fixed trip
+    // count and selects with a conditional move rather than a branch, which
+    // lets the compiler unroll (and for arithmetic keys vectorize) it.
+    size_t best_child_full(size_t first) const {
+        size_t best = first;
+        for (size_t k = 1; k < Arity; ++k) best = comp(data[first + k], data[best]) ? first + k : best;
+        return best;
+    }
+    size_t best_child(size_t first, size_t n) const {
+        size_t best = first;
+        for (size_t c = first + 1; c < n; ++c) best = comp(data[c], data[best]) ? c : best;
+        return best;
     }
-}; 
\ No newline at end of file
+};
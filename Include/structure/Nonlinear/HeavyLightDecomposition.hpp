@@ -0,0 +1,139 @@
+#pragma once
+#include "NaryTree.hpp"
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+// Heavy-light decomposition of a rooted tree given as an adjacency list
+// Vertices are laid out so that every heavy chain and every subtree is a
+// contiguous index range; a u-v path splits into O(log n) such ranges.
+// Pair it with any range structure indexed by index(v) (e.g. SegmentTree).
+class HeavyLightDecomposition {
+    std::vector<int> par, dep, sub, heavy, head, pos;
+public:
+    // adj may be undirected or list children only, and must form one tree
+    // containing root; anything else throws std::invalid_argument
+    HeavyLightDecomposition(const std::vector<std::vector<int>>& adj, int root = 0) {
+        int n = static_cast<int>(adj.size());
+        if (n == 0) return;
+        if (root < 0 || root >= n) throw std::out_of_range("HLD root out of range");
+        par.assign(n, -1); dep.assign(n, 0); sub.assign(n, 1);
+        heavy.assign(n, -1); head.assign(n, 0); pos.assign(n, 0);
+
+        // Iterative DFS order, so deep trees do not overflow the stack
+        std::vector<int> order;
+        order.reserve(n);
+        std::vector<int> stack{root};
+        while (!stack.empty()) {
+            int u = stack.back(); stack.pop_back();
+            // More visits than vertices means a cycle
+            if (order.size() == static_cast<size_t>(n)) throw std::invalid_argument("HLD adjacency list is not a tree");
+            order.push_back(u);
+            for (int v : adj[u]) {
+                if (v < 0 || v >= n) throw std::out_of_range("HLD neighbour out of range");
+                if (v == par[u]) continue;
+                par[v] = u;
+                dep[v] = dep[u] + 1;
+                stack.push_back(v);
+            }
+        }
+        if (order.size() != static_cast<size_t>(n)) throw std::invalid_argument("HLD vertex not reachable from the root");
+        for (int i = n - 1; i > 0; --i) {
+            int v = order[i], p = par[v];
+            sub[p] += sub[v];
+            if (heavy[p] == -1 || sub[v] > sub[heavy[p]]) heavy[p] = v;
+        }
+
+        // Walk each chain from its head, deferring light children; the LIFO
+        // order keeps every subtree contiguous
+        int cur = 0;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            int h = stack.back(); stack.pop_back();
+            for (int u = h; u != -1; u = heavy[u]) {
+                head[u] = h;
+                pos[u] = cur++;
+                for (int v : adj[u])
+                    if (v != par[u] && v != heavy[u]) stack.push_back(v);
+            }
+        }
+    }
+
+    int size() const { return static_cast<int>(pos.size()); }
+    int index(int v) const { return pos[v]; }
+    int parent(int v) const { return par[v]; }
+    int depth(int v) const { return dep[v]; }
+    int subtree_size(int v) const { return sub[v]; }
+
+    int lca(int u, int v) const {
+        while (head[u] != head[v]) {
+            if (dep[head[u]] < dep[head[v]]) std::swap(u, v);
+            u = par[head[u]];
+        }
+        return dep[u] < dep[v] ? u : v;
+    }
+    int distance(int u, int v) const { return dep[u] + dep[v] - 2 * dep[lca(u, v)]; }
+
+    // Calls f(l, r) for each index range [l, r) covering the u-v path.
+    // With edges = true the value of edge (v, parent(v)) lives at index(v)
+    // and the LCA vertex is excluded.
+    template<typename F>
+    void for_each_path(int u, int v, F f, bool edges = false) const {
+        while (head[u] != head[v]) {
+            if (dep[head[u]] < dep[head[v]]) std::swap(u, v);
+            f(pos[head[u]], pos[u] + 1);
+            u = par[head[u]];
+        }
+        if (dep[u] > dep[v]) std::swap(u, v);
+        int l = pos[u] + (edges ? 1 : 0);
+        if (l <= pos[v]) f(l, pos[v] + 1);
+    }
+
+    // Index range [l, r) of the subtree of v
+    std::pair<int, int> subtree_range(int v, bool edges = false) const {
+        return {pos[v] + (edges ? 1 : 0), pos[v] + sub[v]};
+    }
+
+    // Utility: fold range queries over the path; merge must be commutative
+    // e.g. path_query(seg, u, v, std::plus<>(), 0) with a SegmentTree seg
+    template<typename RangeTree, typename Merge, typename T>
+    T path_query(const RangeTree& tree, int u, int v, Merge merge, T acc, bool edges = false) const {
+        for_each_path(u, v, [&](int l, int r) { acc = merge(acc, tree.query(l, r)); }, edges);
+        return acc;
+    }
+
+    // Utility: range-update every segment of the path, e.g.
+    // path_update(u, v, [&](int l, int r) { lazy.apply(l, r, x); })
+    template<typename Apply>
+    void path_update(int u, int v, Apply apply, bool edges = false) const {
+        for_each_path(u, v, apply, edges);
+    }
+
+    template<typename RangeTree>
+    auto subtree_query(const RangeTree& tree, int v, bool edges = false) const {
+        auto range = subtree_range(v, edges);
+        return tree.query(range.first, range.second);
+    }
+
+    // Utility: number the nodes of a NaryTree in preorder and return the
+    // children adjacency list; nodes[i] is the node with vertex id i
+    template<typename T>
+    static std::vector<std::vector<int>> from_nary(const NaryTree<T>& tree,
+                                                   std::vector<const typename NaryTree<T>::Node*>& nodes) {
+        using Node = typename NaryTree<T>::Node;
+        std::vector<std::vector<int>> adj;
+        nodes.clear();
+        if (!tree.root) return adj;
+        std::vector<std::pair<const Node*, int>> stack{{tree.root.get(), -1}};
+        while (!stack.empty()) {
+            auto [node, p] = stack.back(); stack.pop_back();
+            int id = static_cast<int>(nodes.size());
+            nodes.push_back(node);
+            adj.emplace_back();
+            if (p != -1) adj[p].push_back(id);
+            for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+                stack.emplace_back(it->get(), id);
+        }
+        return adj;
+    }
+};
\ No newline at end of file
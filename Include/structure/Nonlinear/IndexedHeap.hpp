@@ -0,0 +1,133 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+// Template-based indexed d-ary heap (binary min-heap by default)
+// Entries are identified by integer handles in [0, capacity); a position map
+// lets decrease_key, increase_key and erase find an entry in O(1) before the
+// O(log n) sift. Each handle is in the heap at most once, so a graph search
+// keeps at most V entries. Capacity grows to fit the largest handle pushed.
+template<typename K, typename Compare = std::less<K>, size_t Arity = 2>
+class IndexedHeap {
+    static_assert(Arity >= 2, "IndexedHeap arity must be at least 2");
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    std::vector<size_t> heap; // handles in heap order
+    std::vector<size_t> pos;  // handle -> index in heap, or npos
+    std::vector<K> keys;      // handle -> key
+    Compare comp;
+public:
+    explicit IndexedHeap(size_t capacity = 0, Compare cmp = Compare())
+        : pos(capacity, npos), keys(capacity), comp(cmp) {
+        heap.reserve(capacity);
+    }
+
+    void push(size_t handle, K key) {
+        if (handle >= pos.size()) {
+            pos.resize(handle + 1, npos);
+            keys.resize(handle + 1);
+        }
+        if (pos[handle] != npos) throw std::invalid_argument("IndexedHeap handle already present");
+        keys[handle] = std::move(key);
+        heap.push_back(handle);
+        sift_up(heap.size() - 1);
+    }
+    // Removes the top entry and returns its handle
+    size_t pop() {
+        if (heap.empty()) throw std::out_of_range("IndexedHeap is empty");
+        size_t handle = heap.front();
+        remove_at(0);
+        return handle;
+    }
+    size_t top() const {
+        if (heap.empty()) throw std::out_of_range("IndexedHeap is empty");
+        return heap.front();
+    }
+    const K& top_key() const { return keys[top()]; }
+
+    bool contains(size_t handle) const { return handle < pos.size() && pos[handle] != npos; }
+    const K& key(size_t handle) const {
+        require(handle);
+        return keys[handle];
+    }
+    // Raises the priority of handle (smaller key for a min-heap)
+    void decrease_key(size_t handle, K key) {
+        require(handle);
+        if (comp(keys[handle], key)) throw std::invalid_argument("IndexedHeap decrease_key would lower priority");
+        keys[handle] = std::move(key);
+        sift_up(pos[handle]);
+    }
+    // Lowers the priority of handle (larger key for a min-heap)
+    void increase_key(size_t handle, K key) {
+        require(handle);
+        if (comp(key, keys[handle])) throw std::invalid_argument("IndexedHeap increase_key would raise priority");
+        keys[handle] = std::move(key);
+        sift_down(pos[handle]);
+    }
+    // Inserts handle or moves it to key, in whichever direction
+    void push_or_update(size_t handle, K key) {
+        if (!contains(handle)) {
+            push(handle, std::move(key));
+            return;
+        }
+        bool up = comp(key, keys[handle]);
+        keys[handle] = std::move(key);
+        if (up) sift_up(pos[handle]);
+        else sift_down(pos[handle]);
+    }
+    void erase(size_t handle) {
+        require(handle);
+        remove_at(pos[handle]);
+    }
+    void clear() {
+        for (size_t handle : heap) pos[handle] = npos;
+        heap.clear();
+    }
+    size_t size() const { return heap.size(); }
+    bool empty() const { return heap.empty(); }
+    size_t capacity() const { return pos.size(); }
+
+private:
+    void require(size_t handle) const {
+        if (!contains(handle)) throw std::out_of_range("IndexedHeap handle not present");
+    }
+    void place(size_t idx, size_t handle) {
+        heap[idx] = handle;
+        pos[handle] = idx;
+    }
+    void remove_at(size_t idx) {
+        size_t handle = heap[idx], last = heap.back();
+        heap.pop_back();
+        pos[handle] = npos;
+        if (idx == heap.size()) return;
+        place(idx, last);
+        // The moved entry can belong above or below its new slot
+        if (idx > 0 && comp(keys[last], keys[heap[(idx - 1) / Arity]])) sift_up(idx);
+        else sift_down(idx);
+    }
+    // Both sifts carry the handle in a hole and write it once at the end
+    void sift_up(size_t idx) {
+        size_t handle = heap[idx];
+        while (idx > 0) {
+            size_t parent = (idx - 1) / Arity;
+            if (!comp(keys[handle], keys[heap[parent]])) break;
+            place(idx, heap[parent]);
+            idx = parent;
+        }
+        place(idx, handle);
+    }
+    void sift_down(size_t idx) {
+        size_t handle = heap[idx], n = heap.size();
+        while (Arity * idx + 1 < n) {
+            size_t first = Arity * idx + 1, last = std::min(first + Arity, n), best = first;
+            for (size_t c = first + 1; c < last; ++c) best = comp(keys[heap[c]], keys[heap[best]]) ? c : best;
+            if (!comp(keys[heap[best]], keys[handle])) break;
+            place(idx, heap[best]);
+            idx = best;
+        }
+        place(idx, handle);
+    }
+};
@@ -0,0 +1,181 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Closed interval [lo, hi], ordered by lo then hi
+template<typename K>
+struct Interval {
+    K lo, hi;
+    Interval() = default;
+    Interval(K l, K h) : lo(std::move(l)), hi(std::move(h)) {}
+    bool overlaps(const K& qlo, const K& qhi) const { return !(qhi < lo) && !(hi < qlo); }
+    bool operator<(const Interval& other) const {
+        if (lo < other.lo) return true;
+        if (other.lo < lo) return false;
+        return hi < other.hi;
+    }
+    bool operator==(const Interval& other) const { return !(*this < other) && !(other < *this); }
+};
+
+// AVL node augmented with the largest endpoint in its subtree; AVLTree
+// refreshes it through augment() on every update and rotation
+template<typename K>
+struct IntervalNode : AVLNodeBase<Interval<K>, IntervalNode<K>> {
+    K max_end;
+    template<typename... Args>
+    explicit IntervalNode(Args&&... args)
+        : AVLNodeBase<Interval<K>, IntervalNode<K>>(std::forward<Args>(args)...), max_end(this->data.hi) {}
+    void augment() {
+        max_end = this->data.hi;
+        if (this->left && max_end < this->left->max_end) max_end = this->left->max_end;
+        if (this->right && max_end < this->right->max_end) max_end = this->right->max_end;
+    }
+};
+
+// Template-based interval tree as a child of AVLTree<Interval<K>>
+// Overlap and stabbing queries prune every subtree whose max_end is left of
+// the query and every right subtree whose intervals start past it. The walk
+// still passes through ancestors of reported intervals that report nothing
+// themselves, so a query costs O(min(n, (k + 1) log n)) for k reported
+// intervals: close to O(log n) per result when k is small, and O(n) at
+// worst. Identical intervals are stored once, like any other AVLTree key.
+template<typename K, typename Alloc = std::allocator<IntervalNode<K>>>
+class IntervalTree : public AVLTree<Interval<K>, Alloc> {
+    using Node = IntervalNode<K>;
+    using Base = AVLTree<Interval<K>, Alloc>;
+public:
+    using Base::Base;
+    IntervalTree(Base&& tree) : Base(std::move(tree)) {}
+
+    using Base::insert;
+    using Base::remove;
+    using Base::contains;
+    bool insert(K lo, K hi) { return Base::insert(Interval<K>(std::move(lo), std::move(hi))); }
+    bool remove(const K& lo, const K& hi) { return Base::remove(Interval<K>(lo, hi)); }
+
+    // Calls f(interval) for every interval overlapping [lo, hi], in order
+    template<typename F>
+    void overlaps(const K& lo, const K& hi, F f) const {
+        if (hi < lo) return;
+        const Node* stack[96];
+        int top = 0;
+        const Node* node = this->root;
+        while (node || top) {
+            // Go left while the left subtree can still reach lo
+            for (; node && !(node->max_end < lo); node = node->left) stack[top++] = node;
+            if (!top) break;
+            node = stack[--top];
+            // Everything from here on starts after hi
+            if (hi < node->data.lo) break;
+            if (!(node->data.hi < lo)) f(node->data);
+            node = node->right;
+        }
+    }
+    // Calls f(interval) for every interval containing point
+    template<typename F>
+    void stab(const K& point, F f) const { overlaps(point, point, f); }
+
+    std::vector<Interval<K>> overlapping(const K& lo, const K& hi) const {
+        std::vector<Interval<K>> result;
+        overlaps(lo, hi, [&](const Interval<K>& interval) { result.push_back(interval); });
+        return result;
+    }
+    bool any_overlap(const K& lo, const K& hi) const {
+        if (hi < lo) return false;
+        const Node* node = this->root;
+        while (node) {
+            if (node->data.overlaps(lo, hi)) return true;
+            // If the left subtree reaches lo it holds an overlap or none of
+            // the right subtree can start before hi
+            if (node->left && !(node->left->max_end < lo)) node = node->left;
+            else node = node->right;
+        }
+        return false;
+    }
+
+    // Answers many queries at once, calling f(queryIndex, interval). Queries
+    // run in order of their lower bound so consecutive searches walk nearby
+    // paths and reuse the cached upper levels of the tree.
+    template<typename F>
+    void overlaps_batch(const std::vector<std::pair<K, K>>& queries, F f) const {
+        std::vector<size_t> order(queries.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::sort(order.begin(), order.end(),
+                  [&](size_t a, size_t b) { return queries[a].first < queries[b].first; });
+        for (size_t qi : order)
+            overlaps(queries[qi].first, queries[qi].second, [&](const Interval<K>& interval) { f(qi, interval); });
+    }
+};
+
+// Read-only interval tree bulk-built in O(n log n) from any set of
+// intervals (duplicates kept). Intervals are sorted by lo in one flat array;
+// the implicit tree roots each range [l, r) at its midpoint, and maxEnd[mid]
+// holds the largest hi in that range, so there are no child pointers.
+// Queries prune the same way as IntervalTree, with the same bound.
+template<typename K>
+class StaticIntervalTree {
+    std::vector<Interval<K>> items;
+    std::vector<K> maxEnd;
+public:
+    StaticIntervalTree() = default;
+    explicit StaticIntervalTree(std::vector<Interval<K>> intervals) : items(std::move(intervals)) {
+        std::sort(items.begin(), items.end());
+        maxEnd.resize(items.size());
+        if (!items.empty()) build(0, items.size());
+    }
+    template<typename Alloc>
+    explicit StaticIntervalTree(const IntervalTree<K, Alloc>& tree)
+        : StaticIntervalTree(std::vector<Interval<K>>(tree.begin(), tree.end())) {}
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    // Intervals in sorted order
+    const Interval<K>& operator[](size_t i) const { return items[i]; }
+
+    // Calls f(interval) for every interval overlapping [lo, hi]
+    template<typename F>
+    void overlaps(const K& lo, const K& hi, F f) const {
+        if (items.empty() || hi < lo) return;
+        // A frame is a range [l, r), or its midpoint alone once expanded;
+        // each level adds at most three frames
+        struct Frame { size_t l, r; bool expanded; };
+        Frame stack[3 * 64];
+        int top = 0;
+        stack[top++] = {0, items.size(), false};
+        while (top) {
+            Frame frame = stack[--top];
+            size_t mid = frame.l + (frame.r - frame.l) / 2;
+            if (frame.expanded) {
+                f(items[mid]);
+                continue;
+            }
+            if (maxEnd[mid] < lo) continue;
+            // Pushed right, mid, left so that results come out in order
+            if (!(hi < items[mid].lo)) {
+                if (mid + 1 < frame.r) stack[top++] = {mid + 1, frame.r, false};
+                if (!(items[mid].hi < lo)) stack[top++] = {frame.l, frame.r, true};
+            }
+            if (frame.l < mid) stack[top++] = {frame.l, mid, false};
+        }
+    }
+    template<typename F>
+    void stab(const K& point, F f) const { overlaps(point, point, f); }
+    std::vector<Interval<K>> overlapping(const K& lo, const K& hi) const {
+        std::vector<Interval<K>> result;
+        overlaps(lo, hi, [&](const Interval<K>& interval) { result.push_back(interval); });
+        return result;
+    }
+private:
+    const K& build(size_t l, size_t r) {
+        size_t mid = l + (r - l) / 2;
+        maxEnd[mid] = items[mid].hi;
+        if (l < mid) maxEnd[mid] = std::max(maxEnd[mid], build(l, mid));
+        if (mid + 1 < r) maxEnd[mid] = std::max(maxEnd[mid], build(mid + 1, r));
+        return maxEnd[mid];
+    }
+};
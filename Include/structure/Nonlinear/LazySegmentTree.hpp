@@ -0,0 +1,332 @@
+#pragma once
+#include "Monoid.hpp"
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+
+// Default element policy for each aggregate, defined after the actions
+template<typename S, typename Action>
+struct DefaultInitFor;
+
+// Template-based lazy segment tree for range updates and range queries
+// Action describes a monoid S with an action F on it, in the style of the
+// AtCoder Library:
+//     using S, F;
+//     static S op(const S&, const S&);       associative, may be non-commutative
+//     static S e();                          identity of op
+//     static S mapping(const F&, const S&);  applies f to a segment aggregate
+//     static F composition(const F& f, const F& g);   f after g
+//     static F id();                         identity of composition
+// Pending actions are pushed down only along the two boundary paths of each
+// operation, iteratively from the top, and aggregates are rebuilt bottom-up,
+// so apply and query are O(log n) without recursion. Ranges are [l, r).
+template<typename Action>
+class LazySegmentTree {
+public:
+    using S = typename Action::S;
+    using F = typename Action::F;
+
+    // count default elements, e.g. 0 for the built-in sum, add-min and
+    // add-max actions (see DefaultInit below)
+    explicit LazySegmentTree(int count = 0)
+        : LazySegmentTree(std::vector<S>(count, typename DefaultInitFor<S, Action>::type()(0, 1))) {}
+    explicit LazySegmentTree(const std::vector<S>& data) : n(static_cast<int>(data.size())) {
+        while ((1 << log) < n) ++log;
+        size = 1 << log;
+        d.assign(2 * size, Action::e());
+        lz.assign(size, Action::id());
+        for (int i = 0; i < n; ++i) d[size + i] = data[i];
+        for (int i = size - 1; i >= 1; --i) update(i);
+    }
+
+    void set(int p, const S& x) {
+        p += size;
+        for (int i = log; i >= 1; --i) push(p >> i);
+        d[p] = x;
+        for (int i = 1; i <= log; ++i) update(p >> i);
+    }
+    S get(int p) {
+        p += size;
+        for (int i = log; i >= 1; --i) push(p >> i);
+        return d[p];
+    }
+    S query(int l, int r) {
+        if (l >= r) return Action::e();
+        l += size;
+        r += size;
+        pushBoundary(l, r);
+        // Left and right partial products keep operand order for
+        // non-commutative op
+        S sml = Action::e(), smr = Action::e();
+        while (l < r) {
+            if (l & 1) sml = Action::op(sml, d[l++]);
+            if (r & 1) smr = Action::op(d[--r], smr);
+            l >>= 1;
+            r >>= 1;
+        }
+        return Action::op(sml, smr);
+    }
+    const S& all() const { return d[1]; }
+
+    void apply(int p, const F& f) {
+        p += size;
+        for (int i = log; i >= 1; --i) push(p >> i);
+        d[p] = Action::mapping(f, d[p]);
+        for (int i = 1; i <= log; ++i) update(p >> i);
+    }
+    void apply(int l, int r, const F& f) {
+        if (l >= r) return;
+        l += size;
+        r += size;
+        pushBoundary(l, r);
+        for (int a = l, b = r; a < b; a >>= 1, b >>= 1) {
+            if (a & 1) applyAll(a++, f);
+            if (b & 1) applyAll(--b, f);
+        }
+        for (int i = 1; i <= log; ++i) {
+            if (((l >> i) << i) != l) update(l >> i);
+            if (((r >> i) << i) != r) update((r - 1) >> i);
+        }
+    }
+
+    // Largest r with pred(query(l, r)) true; pred(e()) must be true and
+    // pred monotone
+    template<typename Pred>
+    int max_right(int l, Pred pred) {
+        if (l == n) return n;
+        l += size;
+        for (int i = log; i >= 1; --i) push(l >> i);
+        S sm = Action::e();
+        do {
+            while (l % 2 == 0) l >>= 1;
+            if (!pred(Action::op(sm, d[l]))) {
+                while (l < size) {
+                    push(l);
+                    l = 2 * l;
+                    if (pred(Action::op(sm, d[l]))) sm = Action::op(sm, d[l++]);
+                }
+                return l - size;
+            }
+            sm = Action::op(sm, d[l++]);
+        } while ((l & -l) != l);
+        return n;
+    }
+    // Smallest l with pred(query(l, r)) true
+    template<typename Pred>
+    int min_left(int r, Pred pred) {
+        if (r == 0) return 0;
+        r += size;
+        for (int i = log; i >= 1; --i) push((r - 1) >> i);
+        S sm = Action::e();
+        do {
+            --r;
+            while (r > 1 && (r % 2)) r >>= 1;
+            if (!pred(Action::op(d[r], sm))) {
+                while (r < size) {
+                    push(r);
+                    r = 2 * r + 1;
+                    if (pred(Action::op(d[r], sm))) sm = Action::op(d[r--], sm);
+                }
+                return r + 1 - size;
+            }
+            sm = Action::op(d[r], sm);
+        } while ((r & -r) != r);
+        return 0;
+    }
+    int length() const { return n; }
+
+private:
+    int n, size = 1, log = 0;
+    std::vector<S> d;
+    std::vector<F> lz;
+
+    void update(int k) { d[k] = Action::op(d[2 * k], d[2 * k + 1]); }
+    void applyAll(int k, const F& f) {
+        d[k] = Action::mapping(f, d[k]);
+        if (k < size) lz[k] = Action::composition(f, lz[k]);
+    }
+    void push(int k) {
+        applyAll(2 * k, lz[k]);
+        applyAll(2 * k + 1, lz[k]);
+        lz[k] = Action::id();
+    }
+    // Pushes pending actions on the paths above leaves l and r - 1, except
+    // where the range covers a whole node
+    void pushBoundary(int l, int r) {
+        for (int i = log; i >= 1; --i) {
+            if (((l >> i) << i) != l) push(l >> i);
+            if (((r >> i) << i) != r) push((r - 1) >> i);
+        }
+    }
+};
+
+// Built-in actions. Sum aggregates carry their segment length so that an
+// add or assign can scale by it; build them with {value, 1} per element.
+template<typename T>
+struct SumLen {
+    T sum;
+    T len;
+};
+
+// Range add, range sum
+template<typename T>
+struct RangeAddSum {
+    using S = SumLen<T>;
+    using F = T;
+    static S op(const S& a, const S& b) { return {a.sum + b.sum, a.len + b.len}; }
+    static S e() { return {T(0), T(0)}; }
+    static S mapping(const F& f, const S& x) { return {x.sum + f * x.len, x.len}; }
+    static F composition(const F& f, const F& g) { return f + g; }
+    static F id() { return T(0); }
+};
+
+// Range assign, range sum
+template<typename T>
+struct RangeAssignSum {
+    using S = SumLen<T>;
+    using F = std::optional<T>;
+    static S op(const S& a, const S& b) { return {a.sum + b.sum, a.len + b.len}; }
+    static S e() { return {T(0), T(0)}; }
+    static S mapping(const F& f, const S& x) { return f ? S{*f * x.len, x.len} : x; }
+    static F composition(const F& f, const F& g) { return f ? f : g; }
+    static F id() { return std::nullopt; }
+};
+
+// Range affine map x -> a * x + b, range sum. Composition is not
+// commutative, so this also exercises operand order.
+template<typename T>
+struct RangeAffineSum {
+    using S = SumLen<T>;
+    using F = Affine<T>;
+    static S op(const S& x, const S& y) { return {x.sum + y.sum, x.len + y.len}; }
+    static S e() { return {T(0), T(0)}; }
+    static S mapping(const F& f, const S& x) { return {f.a * x.sum + f.b * x.len, x.len}; }
+    // f(g(x)) = f.a * (g.a * x + g.b) + f.b
+    static F composition(const F& f, const F& g) { return {f.a * g.a, f.a * g.b + f.b}; }
+    static F id() { return {T(1), T(0)}; }
+};
+
+// Range add, range min / range max. Aggregates carry an explicit flag for
+// segments with no elements (padding, or an empty query), which must not be
+// shifted; a real element may equal max() or lowest(). Build them with
+// {value, false} per element.
+template<typename T>
+struct Extremum {
+    T value;
+    bool empty;
+};
+template<typename T>
+struct RangeAddMin {
+    using S = Extremum<T>;
+    using F = T;
+    static S op(const S& a, const S& b) { return {std::min(a.value, b.value), a.empty && b.empty}; }
+    static S e() { return {std::numeric_limits<T>::max(), true}; }
+    static S mapping(const F& f, const S& x) { return x.empty ? x : S{x.value + f, false}; }
+    static F composition(const F& f, const F& g) { return f + g; }
+    static F id() { return T(0); }
+};
+template<typename T>
+struct RangeAddMax {
+    using S = Extremum<T>;
+    using F = T;
+    static S op(const S& a, const S& b) { return {std::max(a.value, b.value), a.empty && b.empty}; }
+    static S e() { return {std::numeric_limits<T>::lowest(), true}; }
+    static S mapping(const F& f, const S& x) { return x.empty ? x : S{x.value + f, false}; }
+    static F composition(const F& f, const F& g) { return f + g; }
+    static F id() { return T(0); }
+};
+
+// Range assign, range min / range max
+template<typename T>
+struct RangeAssignMin {
+    using S = T;
+    using F = std::optional<T>;
+    static S op(const S& a, const S& b) { return std::min(a, b); }
+    static S e() { return std::numeric_limits<T>::max(); }
+    static S mapping(const F& f, const S& x) { return f ? *f : x; }
+    static F composition(const F& f, const F& g) { return f ? f : g; }
+    static F id() { return std::nullopt; }
+};
+template<typename T>
+struct RangeAssignMax {
+    using S = T;
+    using F = std::optional<T>;
+    static S op(const S& a, const S& b) { return std::max(a, b); }
+    static S e() { return std::numeric_limits<T>::lowest(); }
+    static S mapping(const F& f, const S& x) { return f ? *f : x; }
+    static F composition(const F& f, const F& g) { return f ? f : g; }
+    static F id() { return std::nullopt; }
+};
+
+// Range chmin / chmax (clamp into [lo, hi]), range min and max together.
+// Use Clamp<T>::chmin(v) and Clamp<T>::chmax(v) for the updates; a clamp is
+// monotone, so it maps a segment's min and max directly.
+template<typename T>
+struct MinMax {
+    T min;
+    T max;
+};
+template<typename T>
+struct Clamp {
+    T lo;
+    T hi;
+    static Clamp chmin(T v) { return {std::numeric_limits<T>::lowest(), v}; }
+    static Clamp chmax(T v) { return {v, std::numeric_limits<T>::max()}; }
+    T operator()(const T& x) const { return std::min(std::max(x, lo), hi); }
+};
+template<typename T>
+struct RangeChminChmax {
+    using S = MinMax<T>;
+    using F = Clamp<T>;
+    static S op(const S& a, const S& b) { return {std::min(a.min, b.min), std::max(a.max, b.max)}; }
+    static S e() { return {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()}; }
+    static S mapping(const F& f, const S& x) { return x.min > x.max ? x : S{f(x.min), f(x.max)}; }
+    // Clamping into [g.lo, g.hi] then [f.lo, f.hi] is one clamp into
+    // [f(g.lo), f(g.hi)]
+    static F composition(const F& f, const F& g) { return {f(g.lo), f(g.hi)}; }
+    static F id() { return {std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max()}; }
+};
+
+// Default aggregate of the segment [lo, hi), called as init(lo, hi). It
+// fills LazySegmentTree(count) (one element at a time) and the untouched
+// parts of a DynamicSegmentTree. The default depends on the aggregate:
+//   SumLen (RangeAddSum, RangeAssignSum, RangeAffineSum): SumLenInit, every
+//       element holds 0 and counts toward the segment length
+//   Extremum (RangeAddMin, RangeAddMax): ZeroInit, every element holds 0
+//   anything else (assign min/max, chmin/chmax): IdentityInit
+// IdentityInit with a SumLen or Extremum action instead makes the elements
+// absent: they have no length or value, and adds skip them.
+template<typename Action>
+struct IdentityInit {
+    typename Action::S operator()(int64_t, int64_t) const { return Action::e(); }
+};
+// Throws std::invalid_argument if hi - lo does not fit in T, e.g. for a
+// SumLen<int64_t> tree over all of int64_t
+template<typename T>
+struct SumLenInit {
+    SumLen<T> operator()(int64_t lo, int64_t hi) const {
+        uint64_t len = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+        if constexpr (std::is_integral_v<T>) {
+            if (len > static_cast<uint64_t>(std::numeric_limits<T>::max()))
+                throw std::invalid_argument("SumLenInit segment length does not fit in T");
+        }
+        return {T(0), static_cast<T>(len)};
+    }
+};
+template<typename T>
+struct ZeroInit {
+    Extremum<T> operator()(int64_t, int64_t) const { return {T(0), false}; }
+};
+
+template<typename S, typename Action>
+struct DefaultInitFor { using type = IdentityInit<Action>; };
+template<typename T, typename Action>
+struct DefaultInitFor<SumLen<T>, Action> { using type = SumLenInit<T>; };
+template<typename T, typename Action>
+struct DefaultInitFor<Extremum<T>, Action> { using type = ZeroInit<T>; };
+template<typename Action>
+using DefaultInit = typename DefaultInitFor<typename Action::S, Action>::type;
@@ -0,0 +1,167 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+
+// Template-based min-max heap (double-ended priority queue)
+// Even levels are ordered like a min-heap and odd levels like a max-heap, so
+// min() is the root and max() one of its children. With a bound, the heap
+// keeps only the best `bound` elements (smallest under Compare) and evicts
+// the worst on overflow, which makes it a streaming top-k operator.
+template<typename T, typename Compare = std::less<T>>
+class MinMaxHeap {
+    std::vector<T> data;
+    Compare comp;
+    size_t limit = 0;
+public:
+    MinMaxHeap() = default;
+    explicit MinMaxHeap(Compare cmp) : comp(cmp) {}
+    // Bounded heap holding at most bound elements (0 means unbounded)
+    explicit MinMaxHeap(size_t bound, Compare cmp = Compare()) : comp(cmp), limit(bound) { data.reserve(bound); }
+    // Builds bottom-up in O(n); a bounded heap then drops its worst elements
+    template<typename It>
+    MinMaxHeap(It first, It last, Compare cmp = Compare(), size_t bound = 0)
+        : data(first, last), comp(cmp), limit(bound) {
+        for (size_t i = data.size() / 2; i-- > 0;) trickle_down(i, std::move(data[i]));
+        while (limit && data.size() > limit) pop_max();
+    }
+
+    void push(const T& value) { offer(value); }
+    void push(T&& value) { offer(std::move(value)); }
+    template<typename... Args>
+    void emplace(Args&&... args) { offer(T(std::forward<Args>(args)...)); }
+    // Inserts value; in a full bounded heap, returns whichever of value and
+    // the current max has to go
+    std::optional<T> offer(T value) {
+        if (!limit || data.size() < limit) {
+            data.push_back(std::move(value));
+            bubble_up(data.size() - 1);
+            return std::nullopt;
+        }
+        if (!comp(value, max())) return value;
+        size_t idx = max_index();
+        T evicted = std::move(data[idx]);
+        if (idx > 0 && comp(value, data[0])) std::swap(value, data[0]);
+        trickle_down(idx, std::move(value));
+        return evicted;
+    }
+
+    const T& min() const {
+        if (data.empty()) throw std::out_of_range("MinMaxHeap is empty");
+        return data[0];
+    }
+    const T& max() const {
+        if (data.empty()) throw std::out_of_range("MinMaxHeap is empty");
+        return data[max_index()];
+    }
+    T pop_min() {
+        if (data.empty()) throw std::out_of_range("MinMaxHeap is empty");
+        return remove_at(0);
+    }
+    T pop_max() {
+        if (data.empty()) throw std::out_of_range("MinMaxHeap is empty");
+        return remove_at(max_index());
+    }
+
+    void reserve(size_t n) { data.reserve(n); }
+    void clear() { data.clear(); }
+    size_t size() const { return data.size(); }
+    bool empty() const { return data.empty(); }
+    size_t bound() const { return limit; }
+    // Elements in storage (heap) order, not sorted
+    auto begin() const { return data.begin(); }
+    auto end() const { return data.end(); }
+
+private:
+    static bool min_level(size_t i) {
+        int level = 0;
+        for (++i; i > 1; i >>= 1) ++level;
+        return level % 2 == 0;
+    }
+    // On max levels the order is reversed
+    bool before(const T& a, const T& b, bool minLevel) const { return minLevel ? comp(a, b) : comp(b, a); }
+    size_t max_index() const {
+        if (data.size() < 3) return data.size() - 1;
+        return comp(data[1], data[2]) ? 2 : 1;
+    }
+    T remove_at(size_t idx) {
+        T value = std::move(data[idx]);
+        T last = std::move(data.back());
+        data.pop_back();
+        if (idx < data.size()) trickle_down(idx, std::move(last));
+        return value;
+    }
+    void bubble_up(size_t idx) {
+        if (idx == 0) return;
+        T value = std::move(data[idx]);
+        bool minLevel = min_level(idx);
+        size_t parent = (idx - 1) / 2;
+        // A value on the wrong side of its parent moves to the parent's kind
+        // of level; afterwards it only climbs among grandparents
+        if (before(data[parent], value, minLevel)) {
+            data[idx] = std::move(data[parent]);
+            idx = parent;
+            minLevel = !minLevel;
+        }
+        while (idx >= 3) {
+            size_t grandparent = ((idx - 1) / 2 - 1) / 2;
+            if (!before(value, data[grandparent], minLevel)) break;
+            data[idx] = std::move(data[grandparent]);
+            idx = grandparent;
+        }
+        data[idx] = std::move(value);
+    }
+    // Fills the hole at idx with value, pulling the best child or grandchild
+    // up level by level
+    void trickle_down(size_t idx, T value) {
+        bool minLevel = min_level(idx);
+        size_t n = data.size();
+        while (2 * idx + 1 < n) {
+            size_t best = 2 * idx + 1;
+            bool grandchild = false;
+            size_t candidates[] = {2 * idx + 2, 4 * idx + 3, 4 * idx + 4, 4 * idx + 5, 4 * idx + 6};
+            for (size_t c : candidates) {
+                if (c >= n) break;
+                if (before(data[c], data[best], minLevel)) {
+                    best = c;
+                    grandchild = c > 2 * idx + 2;
+                }
+            }
+            if (!before(data[best], value, minLevel)) break;
+            data[idx] = std::move(data[best]);
+            idx = best;
+            if (!grandchild) break;
+            // The grandchild's parent is on the opposite kind of level; if the
+            // carried value beats it there, they trade places
+            size_t parent = (idx - 1) / 2;
+            if (before(data[parent], value, minLevel)) std::swap(data[parent], value);
+        }
+        data[idx] = std::move(value);
+    }
+};
+
+// Streaming median: the lower half lives in one min-max heap (its max is
+// the low median) and the upper half in another (its min is the high
+// median). Each push is O(log n) and both medians are O(1).
+template<typename T, typename Compare = std::less<T>>
+class RunningMedian {
+    MinMaxHeap<T, Compare> lower, upper;
+    Compare comp;
+public:
+    explicit RunningMedian(Compare cmp = Compare()) : lower(cmp), upper(cmp), comp(cmp) {}
+
+    void push(T value) {
+        if (lower.empty() || !comp(lower.max(), value)) lower.push(std::move(value));
+        else upper.push(std::move(value));
+        // Keep lower.size() - upper.size() in {0, 1}
+        if (lower.size() > upper.size() + 1) upper.push(lower.pop_max());
+        else if (upper.size() > lower.size()) lower.push(upper.pop_min());
+    }
+    const T& median_low() const { return lower.max(); }
+    const T& median_high() const { return upper.size() == lower.size() ? upper.min() : lower.max(); }
+    size_t size() const { return lower.size() + upper.size(); }
+    bool empty() const { return lower.empty(); }
+};
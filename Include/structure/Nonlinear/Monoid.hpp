@@ -0,0 +1,49 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+// Stateless monoids for SegmentTree and friends. Each is a functor combining
+// two values plus a constexpr identity(), so combines inline (and can
+// vectorize) instead of going through std::function.
+template<typename T>
+struct SumMonoid {
+    constexpr T operator()(const T& a, const T& b) const { return a + b; }
+    static constexpr T identity() { return T(0); }
+};
+template<typename T>
+struct MinMonoid {
+    constexpr T operator()(const T& a, const T& b) const { return std::min(a, b); }
+    static constexpr T identity() { return std::numeric_limits<T>::max(); }
+};
+template<typename T>
+struct MaxMonoid {
+    constexpr T operator()(const T& a, const T& b) const { return std::max(a, b); }
+    static constexpr T identity() { return std::numeric_limits<T>::lowest(); }
+};
+template<typename T>
+struct GcdMonoid {
+    constexpr T operator()(const T& a, const T& b) const { return std::gcd(a, b); }
+    static constexpr T identity() { return T(0); }
+};
+template<typename T>
+struct XorMonoid {
+    constexpr T operator()(const T& a, const T& b) const { return a ^ b; }
+    static constexpr T identity() { return T(0); }
+};
+
+// Affine map x -> a * x + b
+template<typename T>
+struct Affine {
+    T a;
+    T b;
+    constexpr T operator()(const T& x) const { return a * x + b; }
+};
+// Composition of affine maps in sequence order: combining f then g gives
+// x -> g(f(x)), so a range query returns the maps applied left to right.
+// Not commutative.
+template<typename T>
+struct AffineMonoid {
+    constexpr Affine<T> operator()(const Affine<T>& f, const Affine<T>& g) const { return {g.a * f.a, g.a * f.b + g.b}; }
+    static constexpr Affine<T> identity() { return {T(1), T(0)}; }
+};
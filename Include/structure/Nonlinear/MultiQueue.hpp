@@ -0,0 +1,130 @@
+#pragma once
+#include "Heap.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <utility>
+
+// Template-based relaxed concurrent priority queue (MultiQueue)
+// Elements are spread over c * p sequential 4-ary heaps, each behind its own
+// lock. push goes to a random heap whose lock is free; pop try-locks two
+// random heaps and takes the better top. Threads rarely contend, so it
+// scales with the thread count, but pops are only approximately in priority
+// order: the popped element is usually among the O(c * p) best.
+// rank_error() reports how far off that is, measured on sampled pops.
+template<typename T, typename Compare = std::less<T>>
+class MultiQueue {
+    struct alignas(64) Lane {
+        std::mutex lock;
+        Heap<T, Compare, 4> heap;
+    };
+    std::unique_ptr<Lane[]> lanes;
+    size_t laneCount;
+    Compare comp;
+    std::atomic<size_t> count{0};
+    // Rank-error sampling: every sampleEvery-th pop of a thread is measured
+    size_t sampleEvery = 0;
+    std::atomic<size_t> errorSum{0}, errorMax{0}, errorSamples{0};
+    // Pops that find every sampled heap empty fall back to a full scan
+    static constexpr int kAttempts = 8;
+
+public:
+    struct RankError {
+        double mean;
+        size_t max;
+        size_t samples;
+    };
+
+    // threads * c heaps; c = 2 is the usual trade-off between rank error
+    // and contention
+    explicit MultiQueue(size_t threads = std::max(1u, std::thread::hardware_concurrency()), size_t c = 2,
+                        Compare cmp = Compare())
+        : lanes(new Lane[std::max<size_t>(2, threads * c)]), laneCount(std::max<size_t>(2, threads * c)),
+          comp(cmp) {}
+    MultiQueue(const MultiQueue&) = delete;
+    MultiQueue& operator=(const MultiQueue&) = delete;
+
+    void push(T value) {
+        while (true) {
+            Lane& lane = lanes[random() % laneCount];
+            std::unique_lock<std::mutex> guard(lane.lock, std::try_to_lock);
+            if (!guard) continue;
+            lane.heap.push(std::move(value));
+            count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    // Removes an element near the top; empty only if the queue was empty
+    // during the final scan
+    std::optional<T> pop() {
+        std::optional<T> result;
+        for (int attempt = 0; attempt < kAttempts && !result; ++attempt) result = popSampled();
+        if (!result) result = popScan();
+        if (result) {
+            count.fetch_sub(1, std::memory_order_relaxed);
+            if (sampleEvery && ++popsSinceSample() % sampleEvery == 0) measure(*result);
+        }
+        return result;
+    }
+    // Approximate while other threads push or pop
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+    size_t heaps() const { return laneCount; }
+
+    // Measures the rank error of every n-th pop per thread (0 disables):
+    // the number of queued elements with higher priority than the popped
+    // one, counted right after the pop. Each sample locks and scans all
+    // heaps, so keep n large outside of tests. Call before sharing the queue.
+    void sample_rank_error(size_t n) { sampleEvery = n; }
+    RankError rank_error() const {
+        size_t samples = errorSamples.load();
+        return {samples ? double(errorSum.load()) / samples : 0.0, errorMax.load(), samples};
+    }
+
+private:
+    static size_t random() {
+        thread_local std::minstd_rand rng(
+            static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+        return rng();
+    }
+    static size_t& popsSinceSample() {
+        thread_local size_t pops = 0;
+        return pops;
+    }
+    std::optional<T> popSampled() {
+        Lane& a = lanes[random() % laneCount];
+        Lane& b = lanes[random() % laneCount];
+        std::unique_lock<std::mutex> guardA(a.lock, std::try_to_lock);
+        std::unique_lock<std::mutex> guardB;
+        if (&b != &a) guardB = std::unique_lock<std::mutex>(b.lock, std::try_to_lock);
+        Lane* best = nullptr;
+        if (guardA && !a.heap.empty()) best = &a;
+        if (guardB && !b.heap.empty() && (!best || comp(b.heap.top(), best->heap.top()))) best = &b;
+        if (!best) return std::nullopt;
+        return best->heap.pop_value();
+    }
+    std::optional<T> popScan() {
+        for (size_t i = 0; i < laneCount; ++i) {
+            std::lock_guard<std::mutex> guard(lanes[i].lock);
+            if (!lanes[i].heap.empty()) return lanes[i].heap.pop_value();
+        }
+        return std::nullopt;
+    }
+    void measure(const T& popped) {
+        size_t better = 0;
+        for (size_t i = 0; i < laneCount; ++i) {
+            std::lock_guard<std::mutex> guard(lanes[i].lock);
+            for (const T& value : lanes[i].heap) better += comp(value, popped);
+        }
+        errorSum.fetch_add(better);
+        errorSamples.fetch_add(1);
+        size_t seen = errorMax.load();
+        while (better > seen && !errorMax.compare_exchange_weak(seen, better)) {}
+    }
+};
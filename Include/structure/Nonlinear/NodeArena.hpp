@@ -0,0 +1,112 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Slab arena for fixed-size tree nodes
+// Slots are bump-allocated from geometrically growing blocks and recycled
+// through an intrusive free list. release() drops every slot at once and
+// keeps the largest block for reuse. Not thread-safe.
+class NodeArena {
+    struct FreeSlot { FreeSlot* next; };
+    std::vector<std::pair<void*, size_t>> blocks; // block, slot count
+    size_t slotSize = 0, slotAlign = alignof(std::max_align_t);
+    char* cursor = nullptr;
+    char* limit = nullptr;
+    FreeSlot* freeList = nullptr;
+    size_t nextSlots;
+    static constexpr size_t kMaxBlockSlots = 1 << 16;
+public:
+    explicit NodeArena(size_t initialSlots = 32) : nextSlots(std::max<size_t>(initialSlots, 1)) {}
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+    ~NodeArena() {
+        for (auto& block : blocks) freeBlock(block.first);
+    }
+
+    // All slots have the size of the first request
+    void* allocate(size_t bytes, size_t alignment) {
+        if (!slotSize) {
+            slotAlign = std::max(alignment, alignof(FreeSlot));
+            slotSize = (std::max(bytes, sizeof(FreeSlot)) + slotAlign - 1) / slotAlign * slotAlign;
+        }
+        if (bytes > slotSize || alignment > slotAlign) throw std::bad_alloc();
+        if (freeList) {
+            FreeSlot* slot = freeList;
+            freeList = slot->next;
+            return slot;
+        }
+        if (cursor == limit) grow();
+        void* p = cursor;
+        cursor += slotSize;
+        return p;
+    }
+    void deallocate(void* p) {
+        FreeSlot* slot = static_cast<FreeSlot*>(p);
+        slot->next = freeList;
+        freeList = slot;
+    }
+    // Forgets every allocation in O(blocks); objects are not destroyed
+    void release() {
+        if (blocks.empty()) return;
+        auto largest = blocks.back();
+        blocks.pop_back();
+        for (auto& block : blocks) freeBlock(block.first);
+        blocks.assign(1, largest);
+        cursor = static_cast<char*>(largest.first);
+        limit = cursor + largest.second * slotSize;
+        freeList = nullptr;
+    }
+private:
+    void grow() {
+        size_t slots = nextSlots;
+        nextSlots = std::min(nextSlots * 2, kMaxBlockSlots);
+        void* block = ::operator new(slots * slotSize, std::align_val_t(slotAlign));
+        blocks.emplace_back(block, slots);
+        cursor = static_cast<char*>(block);
+        limit = cursor + slots * slotSize;
+    }
+    void freeBlock(void* block) { ::operator delete(block, std::align_val_t(slotAlign)); }
+};
+
+// Allocator handle over a shared NodeArena; each default-constructed
+// allocator gets its own arena. Trees pass copies around, so the arena lives
+// as long as any tree or allocator still refers to it.
+template<typename U>
+class ArenaAllocator {
+    template<typename> friend class ArenaAllocator;
+    std::shared_ptr<NodeArena> arena;
+public:
+    using value_type = U;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() : arena(std::make_shared<NodeArena>()) {}
+    explicit ArenaAllocator(std::shared_ptr<NodeArena> shared) : arena(std::move(shared)) {}
+    template<typename V>
+    ArenaAllocator(const ArenaAllocator<V>& other) : arena(other.arena) {}
+
+    U* allocate(size_t n) {
+        if (n == 1) return static_cast<U*>(arena->allocate(sizeof(U), alignof(U)));
+        return static_cast<U*>(::operator new(n * sizeof(U)));
+    }
+    void deallocate(U* p, size_t n) {
+        if (n == 1) arena->deallocate(p);
+        else ::operator delete(p);
+    }
+    // Drops every node at once if no other allocator shares the arena
+    bool release() {
+        if (arena.use_count() != 1) return false;
+        arena->release();
+        return true;
+    }
+
+    template<typename V>
+    bool operator==(const ArenaAllocator<V>& other) const { return arena == other.arena; }
+    template<typename V>
+    bool operator!=(const ArenaAllocator<V>& other) const { return arena != other.arena; }
+};
\ No newline at end of file
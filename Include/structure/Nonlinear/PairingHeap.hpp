@@ -0,0 +1,208 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+
+// Pairing heap node in child/sibling form; prev is the parent for a first
+// child and the left sibling otherwise
+template<typename T>
+struct PairingNode {
+    T data;
+    PairingNode* child;
+    PairingNode* sibling;
+    PairingNode* prev;
+    template<typename... Args>
+    explicit PairingNode(Args&&... args)
+        : data(std::forward<Args>(args)...), child(nullptr), sibling(nullptr), prev(nullptr) {}
+};
+
+// Template-based pairing heap (min-heap by default)
+// push and meld link two roots in O(1); pop merges the root's children with
+// the two-pass pairing rule in O(log n) amortized; decrease_key cuts the
+// node's subtree and links it to the root, o(log n) amortized. push returns
+// a handle that stays valid until that element is popped or erased.
+// Nodes come from Alloc; ArenaAllocator<PairingNode<T>> over a shared
+// NodeArena pools them, and heaps that meld must share it.
+template<typename T, typename Compare = std::less<T>, typename Alloc = std::allocator<PairingNode<T>>>
+class PairingHeap {
+    using Node = PairingNode<T>;
+    Node* root = nullptr;
+    size_t count = 0;
+    Compare comp;
+    Alloc alloc;
+public:
+    class handle {
+        friend class PairingHeap;
+        Node* node = nullptr;
+        explicit handle(Node* n) : node(n) {}
+    public:
+        handle() = default;
+        const T& operator*() const { return node->data; }
+        const T* operator->() const { return &node->data; }
+        bool operator==(const handle& other) const { return node == other.node; }
+        bool operator!=(const handle& other) const { return node != other.node; }
+    };
+
+    explicit PairingHeap(Compare cmp = Compare(), const Alloc& allocator = Alloc()) : comp(cmp), alloc(allocator) {}
+    explicit PairingHeap(const Alloc& allocator) : alloc(allocator) {}
+    ~PairingHeap() { clear(); }
+    PairingHeap(const PairingHeap&) = delete;
+    PairingHeap& operator=(const PairingHeap&) = delete;
+    PairingHeap(PairingHeap&& other) noexcept
+        : root(other.root), count(other.count), comp(other.comp), alloc(other.alloc) {
+        other.root = nullptr;
+        other.count = 0;
+    }
+    PairingHeap& operator=(PairingHeap&& other) noexcept {
+        if (this != &other) {
+            clear();
+            root = other.root;
+            count = other.count;
+            comp = other.comp;
+            alloc = other.alloc;
+            other.root = nullptr;
+            other.count = 0;
+        }
+        return *this;
+    }
+
+    handle push(const T& value) { return emplace(value); }
+    handle push(T&& value) { return emplace(std::move(value)); }
+    template<typename... Args>
+    handle emplace(Args&&... args) {
+        Node* node = create_node(std::forward<Args>(args)...);
+        root = root ? link(root, node) : node;
+        ++count;
+        return handle(node);
+    }
+    const T& top() const {
+        if (!root) throw std::out_of_range("PairingHeap is empty");
+        return root->data;
+    }
+    void pop() { pop_value(); }
+    // Removes the top element and returns it by move
+    T pop_value() {
+        if (!root) throw std::out_of_range("PairingHeap is empty");
+        Node* old = root;
+        root = mergePairs(old->child);
+        T value = std::move(old->data);
+        destroy_node(old);
+        --count;
+        return value;
+    }
+    // Moves every element of other into this heap in O(1); handles into
+    // other stay valid and now refer to this heap
+    void meld(PairingHeap&& other) {
+        if (this == &other || !other.root) return;
+        if (!(alloc == other.alloc)) throw std::invalid_argument("PairingHeap operands must share an allocator");
+        root = root ? link(root, other.root) : other.root;
+        count += other.count;
+        other.root = nullptr;
+        other.count = 0;
+    }
+    // Gives h the higher-priority value (smaller for a min-heap)
+    void decrease_key(handle h, T value) {
+        Node* node = h.node;
+        if (comp(node->data, value)) throw std::invalid_argument("PairingHeap decrease_key would lower priority");
+        node->data = std::move(value);
+        if (node == root) return;
+        cut(node);
+        root = link(root, node);
+    }
+    void erase(handle h) {
+        Node* node = h.node;
+        if (node == root) {
+            pop();
+            return;
+        }
+        cut(node);
+        Node* children = mergePairs(node->child);
+        if (children) root = link(root, children);
+        destroy_node(node);
+        --count;
+    }
+    // Frees every node without recursion by rotating children up
+    void clear() {
+        Node* node = root;
+        while (node) {
+            if (Node* c = node->child) {
+                node->child = c->sibling;
+                c->sibling = node;
+                node = c;
+            } else {
+                Node* next = node->sibling;
+                destroy_node(node);
+                node = next;
+            }
+        }
+        root = nullptr;
+        count = 0;
+    }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    Alloc get_allocator() const { return alloc; }
+
+private:
+    template<typename... Args>
+    Node* create_node(Args&&... args) {
+        Node* node = std::allocator_traits<Alloc>::allocate(alloc, 1);
+        try {
+            std::allocator_traits<Alloc>::construct(alloc, node, std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator_traits<Alloc>::deallocate(alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+    void destroy_node(Node* node) {
+        std::allocator_traits<Alloc>::destroy(alloc, node);
+        std::allocator_traits<Alloc>::deallocate(alloc, node, 1);
+    }
+    // Makes the lower-priority root the first child of the other
+    Node* link(Node* a, Node* b) {
+        if (comp(b->data, a->data)) std::swap(a, b);
+        b->sibling = a->child;
+        if (a->child) a->child->prev = b;
+        b->prev = a;
+        a->child = b;
+        a->sibling = a->prev = nullptr;
+        return a;
+    }
+    // Detaches node (and its subtree) from its parent's child list
+    static void cut(Node* node) {
+        if (node->prev->child == node) node->prev->child = node->sibling;
+        else node->prev->sibling = node->sibling;
+        if (node->sibling) node->sibling->prev = node->prev;
+        node->sibling = node->prev = nullptr;
+    }
+    // Two-pass pairing: link siblings in pairs left to right, then fold the
+    // pairs right to left. The pairs are chained through sibling in reverse,
+    // so both passes are loops.
+    Node* mergePairs(Node* first) {
+        if (!first) return nullptr;
+        Node* pairs = nullptr;
+        while (first) {
+            Node* a = first;
+            Node* b = a->sibling;
+            first = b ? b->sibling : nullptr;
+            a->sibling = a->prev = nullptr;
+            if (b) {
+                b->sibling = b->prev = nullptr;
+                a = link(a, b);
+            }
+            a->sibling = pairs;
+            pairs = a;
+        }
+        Node* result = pairs;
+        pairs = pairs->sibling;
+        result->sibling = nullptr;
+        while (pairs) {
+            Node* next = pairs->sibling;
+            result = link(pairs, result);
+            pairs = next;
+        }
+        return result;
+    }
+};
@@ -0,0 +1,259 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Template-based persistent (path-copying) AVL set
+// Nodes are immutable and shared between versions through reference counts;
+// an update copies only the O(log n) search path and publishes the new root
+// with a single atomic pointer store. Readers take a Snapshot, which pins one
+// version for as long as it lives. snapshot() takes no lock: it announces the
+// root it read in a hazard slot, so the writer keeps that root alive until
+// the reader holds its own reference. Writers are serialized with a mutex.
+template<typename T>
+class PersistentAVLTree {
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+    struct Node : std::enable_shared_from_this<Node> {
+        T data;
+        NodePtr left, right;
+        int height;
+        size_t size;
+        Node(const T& val, NodePtr l, NodePtr r)
+            : data(val), left(std::move(l)), right(std::move(r)),
+              height(1 + std::max(heightOf(left), heightOf(right))),
+              size(1 + sizeOf(left) + sizeOf(right)) {}
+    };
+
+    // Writer-owned current and replaced roots; readers only see published
+    NodePtr root;
+    std::vector<NodePtr> retired;
+    std::atomic<const Node*> published{nullptr};
+    std::mutex writer;
+
+    // A reader claims a slot for the few instructions between loading the
+    // root and taking a reference to it
+    struct alignas(64) HazardSlot {
+        std::atomic<bool> claimed{false};
+        std::atomic<const Node*> node{nullptr};
+    };
+    static constexpr size_t kHazardSlots = 64;
+    mutable HazardSlot hazards[kHazardSlots];
+
+public:
+    // Immutable view of one version
+    class Snapshot {
+        NodePtr root;
+    public:
+        Snapshot() = default;
+        explicit Snapshot(NodePtr r) : root(std::move(r)) {}
+
+        size_t size() const { return sizeOf(root); }
+        bool empty() const { return !root; }
+        bool contains(const T& value) const {
+            const Node* node = root.get();
+            while (node) {
+                if (value < node->data) node = node->left.get();
+                else if (node->data < value) node = node->right.get();
+                else return true;
+            }
+            return false;
+        }
+        // k-th smallest (0-based)
+        const T& select(size_t k) const {
+            if (k >= size()) throw std::out_of_range("PersistentAVLTree select index out of range");
+            const Node* node = root.get();
+            while (true) {
+                size_t leftSize = sizeOf(node->left);
+                if (k < leftSize) node = node->left.get();
+                else if (k == leftSize) return node->data;
+                else { k -= leftSize + 1; node = node->right.get(); }
+            }
+        }
+        // Number of elements strictly less than value
+        size_t rank(const T& value) const {
+            size_t r = 0;
+            const Node* node = root.get();
+            while (node) {
+                if (node->data < value) { r += sizeOf(node->left) + 1; node = node->right.get(); }
+                else node = node->left.get();
+            }
+            return r;
+        }
+        // Utility: Inorder traversal (explicit stack)
+        void inorder(std::function<void(const T&)> visit) const {
+            std::vector<const Node*> stack;
+            const Node* node = root.get();
+            while (node || !stack.empty()) {
+                for (; node; node = node->left.get()) stack.push_back(node);
+                node = stack.back(); stack.pop_back();
+                visit(node->data);
+                node = node->right.get();
+            }
+        }
+    };
+
+    PersistentAVLTree() = default;
+    PersistentAVLTree(const PersistentAVLTree&) = delete;
+    PersistentAVLTree& operator=(const PersistentAVLTree&) = delete;
+
+    // Current version; safe to call concurrently with writers and lock-free
+    // (with more than kHazardSlots concurrent callers, extras retry slots)
+    Snapshot snapshot() const {
+        HazardSlot& slot = claimSlot();
+        const Node* current = published.load();
+        while (true) {
+            slot.node.store(current);
+            // Still published after the announcement: the writer's scan in
+            // publish() will see the slot and keep this root alive
+            const Node* again = published.load();
+            if (again == current) break;
+            current = again;
+        }
+        NodePtr pinned = current ? current->shared_from_this() : nullptr;
+        slot.node.store(nullptr, std::memory_order_release);
+        slot.claimed.store(false, std::memory_order_release);
+        return Snapshot(std::move(pinned));
+    }
+
+    bool insert(const T& value) {
+        std::lock_guard<std::mutex> lock(writer);
+        bool changed = false;
+        NodePtr next = insertRec(root, value, changed);
+        if (changed) publish(std::move(next));
+        return changed;
+    }
+    bool remove(const T& value) {
+        std::lock_guard<std::mutex> lock(writer);
+        bool changed = false;
+        NodePtr next = removeRec(root, value, changed);
+        if (changed) publish(std::move(next));
+        return changed;
+    }
+    // Applies several updates and publishes them as one version;
+    // f receives an Editor with insert/remove
+    template<typename F>
+    void batch(F f) {
+        std::lock_guard<std::mutex> lock(writer);
+        Editor editor(root);
+        f(editor);
+        if (editor.root != root) publish(std::move(editor.root));
+    }
+    void clear() {
+        std::lock_guard<std::mutex> lock(writer);
+        publish(nullptr);
+    }
+
+    class Editor {
+        friend class PersistentAVLTree;
+        NodePtr root;
+        explicit Editor(NodePtr r) : root(std::move(r)) {}
+    public:
+        bool insert(const T& value) {
+            bool changed = false;
+            NodePtr next = insertRec(root, value, changed);
+            if (changed) root = std::move(next);
+            return changed;
+        }
+        bool remove(const T& value) {
+            bool changed = false;
+            NodePtr next = removeRec(root, value, changed);
+            if (changed) root = std::move(next);
+            return changed;
+        }
+    };
+
+private:
+    void publish(NodePtr next) {
+        published.store(next.get());
+        retired.push_back(std::move(root));
+        root = std::move(next);
+        // Drop replaced roots no reader has announced; one announced later
+        // fails the reader's re-check, since it is no longer published
+        retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                     [&](const NodePtr& old) { return !old || !hazarded(old.get()); }),
+                      retired.end());
+    }
+    bool hazarded(const Node* node) const {
+        for (const HazardSlot& slot : hazards)
+            if (slot.node.load() == node) return true;
+        return false;
+    }
+    HazardSlot& claimSlot() const {
+        size_t i = std::hash<std::thread::id>()(std::this_thread::get_id());
+        for (;; ++i) {
+            HazardSlot& slot = hazards[i % kHazardSlots];
+            bool expected = false;
+            if (!slot.claimed.load(std::memory_order_relaxed) &&
+                slot.claimed.compare_exchange_weak(expected, true, std::memory_order_acquire))
+                return slot;
+        }
+    }
+    static int heightOf(const NodePtr& node) { return node ? node->height : 0; }
+    static size_t sizeOf(const NodePtr& node) { return node ? node->size : 0; }
+    static NodePtr make(const T& data, NodePtr l, NodePtr r) {
+        return std::make_shared<Node>(data, std::move(l), std::move(r));
+    }
+    // Builds a node over l and r, rotating (by copying) if they differ in
+    // height by two
+    static NodePtr balance(const T& data, NodePtr l, NodePtr r) {
+        int hl = heightOf(l), hr = heightOf(r);
+        if (hl > hr + 1) {
+            if (heightOf(l->left) >= heightOf(l->right))
+                return make(l->data, l->left, make(data, l->right, std::move(r)));
+            const Node* lr = l->right.get();
+            return make(lr->data, make(l->data, l->left, lr->left), make(data, lr->right, std::move(r)));
+        }
+        if (hr > hl + 1) {
+            if (heightOf(r->right) >= heightOf(r->left))
+                return make(r->data, make(data, std::move(l), r->left), r->right);
+            const Node* rl = r->left.get();
+            return make(rl->data, make(data, std::move(l), rl->left), make(r->data, rl->right, r->right));
+        }
+        return make(data, std::move(l), std::move(r));
+    }
+    static NodePtr insertRec(const NodePtr& node, const T& value, bool& changed) {
+        if (!node) {
+            changed = true;
+            return make(value, nullptr, nullptr);
+        }
+        if (value < node->data) {
+            NodePtr l = insertRec(node->left, value, changed);
+            return changed ? balance(node->data, std::move(l), node->right) : node;
+        }
+        if (node->data < value) {
+            NodePtr r = insertRec(node->right, value, changed);
+            return changed ? balance(node->data, node->left, std::move(r)) : node;
+        }
+        return node; // no duplicates
+    }
+    static NodePtr removeMin(const NodePtr& node, const Node*& min) {
+        if (!node->left) {
+            min = node.get();
+            return node->right;
+        }
+        return balance(node->data, removeMin(node->left, min), node->right);
+    }
+    static NodePtr removeRec(const NodePtr& node, const T& value, bool& changed) {
+        if (!node) return node;
+        if (value < node->data) {
+            NodePtr l = removeRec(node->left, value, changed);
+            return changed ? balance(node->data, std::move(l), node->right) : node;
+        }
+        if (node->data < value) {
+            NodePtr r = removeRec(node->right, value, changed);
+            return changed ? balance(node->data, node->left, std::move(r)) : node;
+        }
+        changed = true;
+        if (!node->left) return node->right;
+        if (!node->right) return node->left;
+        const Node* min = nullptr;
+        NodePtr r = removeMin(node->right, min);
+        return balance(min->data, node->left, std::move(r));
+    }
+};
\ No newline at end of file
@@ -0,0 +1,228 @@
+#pragma once
+#include "Monoid.hpp"
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+// Template-based persistent segment tree (path copying)
+// Every update copies the O(log n) nodes on one root-to-leaf path and
+// records the new root as a new version; all other nodes are shared with
+// the version it was derived from, so each version costs O(log n) space.
+// Nodes live in one vector and refer to children by 32-bit index. Node 0 is
+// a shared all-identity subtree (its children are itself), so an empty tree
+// of any size is a single node. Op is a stateless monoid from Monoid.hpp;
+// ranges are [l, r) and versions are numbered from 0 in creation order.
+template<typename T, typename Op = SumMonoid<T>>
+class PersistentSegmentTree {
+public:
+    using version_type = uint32_t;
+
+private:
+    struct Node {
+        T value;
+        uint32_t left;
+        uint32_t right;
+    };
+    std::vector<Node> nodes;
+    std::vector<uint32_t> roots;
+    int n;
+    Op op;
+    // Depth bound for int sizes
+    static constexpr int kMaxDepth = 32;
+
+public:
+    // Version 0 has every element equal to the identity
+    explicit PersistentSegmentTree(int size = 0) : nodes{{Op::identity(), 0, 0}}, roots{0}, n(size) {}
+    // Version 0 holds data
+    explicit PersistentSegmentTree(const std::vector<T>& data) : PersistentSegmentTree(static_cast<int>(data.size())) {
+        if (n == 0) return;
+        nodes.reserve(2 * size_t(n));
+        // Bottom-up pairing of adjacent subtrees, keeping the midpoint split
+        // used by update and query: the tree over [lo, hi) is built from the
+        // trees over [lo, mid) and [mid, hi)
+        struct Frame { int lo, hi; bool expanded; };
+        std::vector<Frame> stack{{0, n, false}};
+        std::vector<uint32_t> built;
+        while (!stack.empty()) {
+            Frame f = stack.back();
+            stack.pop_back();
+            if (f.hi - f.lo == 1) {
+                built.push_back(newNode(data[f.lo], 0, 0));
+            } else if (f.expanded) {
+                uint32_t r = built.back();
+                built.pop_back();
+                uint32_t l = built.back();
+                built.pop_back();
+                built.push_back(newNode(op(nodes[l].value, nodes[r].value), l, r));
+            } else {
+                int mid = f.lo + (f.hi - f.lo) / 2;
+                stack.push_back({f.lo, f.hi, true});
+                stack.push_back({mid, f.hi, false});
+                stack.push_back({f.lo, mid, false});
+            }
+        }
+        roots[0] = built.back();
+    }
+
+    // New version equal to v with element pos set to value
+    version_type update(version_type v, int pos, const T& value) {
+        return modify(v, pos, [&](const T&) { return value; });
+    }
+    // New version equal to v with element pos replaced by op(old, value),
+    // e.g. an increment for SumMonoid
+    version_type add(version_type v, int pos, const T& value) {
+        return modify(v, pos, [&](const T& old) { return op(old, value); });
+    }
+
+    T query(version_type v, int l, int r) const { // [l, r)
+        uint32_t root = rootOf(v);
+        if (l < 0 || r > n) throw std::out_of_range("PersistentSegmentTree query range out of bounds");
+        T result = Op::identity();
+        if (l >= r) return result;
+        // Left-first DFS so covered nodes are combined in array order
+        struct Frame { uint32_t node; int lo, hi; };
+        Frame stack[2 * kMaxDepth + 2];
+        int top = 0;
+        stack[top++] = {root, 0, n};
+        while (top) {
+            Frame f = stack[--top];
+            if (f.node == 0) continue;
+            if (l <= f.lo && f.hi <= r) {
+                result = op(result, nodes[f.node].value);
+                continue;
+            }
+            int mid = f.lo + (f.hi - f.lo) / 2;
+            if (mid < r) stack[top++] = {nodes[f.node].right, mid, f.hi};
+            if (l < mid) stack[top++] = {nodes[f.node].left, f.lo, mid};
+        }
+        return result;
+    }
+    T get(version_type v, int pos) const { return query(v, pos, pos + 1); }
+    const T& all(version_type v) const { return nodes[rootOf(v)].value; }
+
+    // For counting trees (SumMonoid over counts): the smallest position p
+    // such that the sum over [0, p] in version hi minus that in version lo
+    // exceeds k. Walks both versions side by side in O(log n).
+    int select(version_type hi, version_type lo, T k) const {
+        uint32_t a = rootOf(hi), b = rootOf(lo);
+        if (n == 0 || !(k < nodes[a].value - nodes[b].value))
+            throw std::out_of_range("PersistentSegmentTree select rank out of range");
+        int l = 0, r = n;
+        while (r - l > 1) {
+            int mid = l + (r - l) / 2;
+            T leftCount = nodes[nodes[a].left].value - nodes[nodes[b].left].value;
+            if (k < leftCount) {
+                a = nodes[a].left;
+                b = nodes[b].left;
+                r = mid;
+            } else {
+                k = k - leftCount;
+                a = nodes[a].right;
+                b = nodes[b].right;
+                l = mid;
+            }
+        }
+        return l;
+    }
+
+    version_type latest() const { return static_cast<version_type>(roots.size() - 1); }
+    size_t versions() const { return roots.size(); }
+    int size() const { return n; }
+    size_t node_count() const { return nodes.size(); }
+    // Room for about `updates` more updates without reallocating
+    void reserve(size_t updates) {
+        int depth = 1;
+        while ((1LL << (depth - 1)) < n) ++depth;
+        nodes.reserve(nodes.size() + updates * depth);
+        roots.reserve(roots.size() + updates);
+    }
+
+private:
+    uint32_t rootOf(version_type v) const {
+        if (v >= roots.size()) throw std::out_of_range("PersistentSegmentTree version out of range");
+        return roots[v];
+    }
+    uint32_t newNode(const T& value, uint32_t left, uint32_t right) {
+        if (nodes.size() > std::numeric_limits<uint32_t>::max())
+            throw std::length_error("PersistentSegmentTree node index exceeds 32 bits");
+        nodes.push_back({value, left, right});
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+    // Copies the path to pos, bottom-up, and records the new root
+    template<typename F>
+    version_type modify(version_type v, int pos, F f) {
+        uint32_t node = rootOf(v);
+        if (pos < 0 || pos >= n) throw std::out_of_range("PersistentSegmentTree index out of range");
+        uint32_t path[kMaxDepth];
+        bool wentRight[kMaxDepth];
+        int depth = 0;
+        for (int lo = 0, hi = n; hi - lo > 1; ++depth) {
+            int mid = lo + (hi - lo) / 2;
+            path[depth] = node;
+            wentRight[depth] = pos >= mid;
+            if (wentRight[depth]) {
+                node = nodes[node].right;
+                lo = mid;
+            } else {
+                node = nodes[node].left;
+                hi = mid;
+            }
+        }
+        uint32_t cur = newNode(f(nodes[node].value), 0, 0);
+        while (depth--) {
+            // Copy the sibling index first; newNode may reallocate nodes
+            uint32_t left = wentRight[depth] ? nodes[path[depth]].left : cur;
+            uint32_t right = wentRight[depth] ? cur : nodes[path[depth]].right;
+            cur = newNode(op(nodes[left].value, nodes[right].value), left, right);
+        }
+        roots.push_back(cur);
+        return latest();
+    }
+};
+
+// Static k-th smallest and rank queries on any subarray, in O(log n) each.
+// Version i of a persistent counting tree over the distinct values holds
+// the counts of data[0, i), so data[l, r) is version r minus version l.
+template<typename T, typename Compare = std::less<T>>
+class RangeKthSmallest {
+    std::vector<T> values;
+    PersistentSegmentTree<int> counts;
+    Compare comp;
+public:
+    explicit RangeKthSmallest(const std::vector<T>& data, Compare cmp = Compare())
+        : values(data), comp(cmp) {
+        std::sort(values.begin(), values.end(), comp);
+        values.erase(std::unique(values.begin(), values.end(),
+                                 [&](const T& a, const T& b) { return !comp(a, b) && !comp(b, a); }),
+                     values.end());
+        counts = PersistentSegmentTree<int>(static_cast<int>(values.size()));
+        counts.reserve(data.size());
+        for (const T& x : data) counts.add(counts.latest(), indexOf(x), 1);
+    }
+
+    // k-th smallest (0-based) of data[l, r)
+    const T& kth(int l, int r, int k) const {
+        checkRange(l, r);
+        if (k < 0 || k >= r - l) throw std::out_of_range("RangeKthSmallest rank out of range");
+        return values[counts.select(r, l, k)];
+    }
+    // Number of elements of data[l, r) less than x
+    int count_less(int l, int r, const T& x) const {
+        checkRange(l, r);
+        int idx = indexOf(x);
+        return counts.query(r, 0, idx) - counts.query(l, 0, idx);
+    }
+    int size() const { return static_cast<int>(counts.versions() - 1); }
+
+private:
+    int indexOf(const T& x) const {
+        return static_cast<int>(std::lower_bound(values.begin(), values.end(), x, comp) - values.begin());
+    }
+    void checkRange(int l, int r) const {
+        if (l < 0 || r > size() || l > r) throw std::out_of_range("RangeKthSmallest range out of bounds");
+    }
+};
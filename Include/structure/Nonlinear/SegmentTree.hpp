@@ -1,9 +1,13 @@
 #pragma once
+#include "Monoid.hpp"
 #include <vector>
 #include <functional>
-#include <stdexcept>
+#include <utility>
 
 // Template-based Segment Tree for range queries and point updates
+// Fast path: pass a stateless monoid from Monoid.hpp as F, e.g.
+// SegmentTree<long, SumMonoid<long>> st(n); combines then inline instead of
+// going through std::function, and the identity comes from F::identity().
 template<typename T, typename F = std::function<T(const T&, const T&)>>
 class SegmentTree {
     std::vector<T> tree;
@@ -14,6 +18,12 @@ public:
     SegmentTree(int size, F merge_func, T id) : n(size), merge(merge_func), identity(id) {
         tree.assign(2 * n, identity);
     }
+    template<typename G = F, typename = decltype(G::identity())>
+    explicit SegmentTree(int size) : SegmentTree(size, G(), G::identity()) {}
+    template<typename G = F, typename = decltype(G::identity())>
+    explicit SegmentTree(const std::vector<T>& data) : SegmentTree(static_cast<int>(data.size())) {
+        build(data);
+    }
     void build(const std::vector<T>& data) {
         for (int i = 0; i < n; ++i) tree[n + i] = data[i];
         for (int i = n - 1; i > 0; --i) tree[i] = merge(tree[i << 1], tree[i << 1 | 1]);
@@ -32,4 +42,13 @@ public:
         }
         return merge(resl, resr);
     }
-}; 
\ No newline at end of file
+    // Answers each [l, r) in ranges. Node indices depend only on l and r,
+    // never on loaded values, so consecutive queries are independent and
+    // their cache misses overlap without explicit interleaving.
+    std::vector<T> query_many(const std::vector<std::pair<int, int>>& ranges) const {
+        std::vector<T> results;
+        results.reserve(ranges.size());
+        for (const auto& range : ranges) results.push_back(query(range.first, range.second));
+        return results;
+    }
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include "Monoid.hpp"
+#include "../../Algorithms/Parallel.hpp"
+#include <vector>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+// Template-based sparse table for O(1) range queries over a static array
+// Op must be associative and idempotent (op(x, x) == x), e.g. MinMonoid,
+// MaxMonoid or GcdMonoid: a query [l, r) combines the two overlapping
+// power-of-two windows that cover it. Row k holds op over [i, i + 2^k) for
+// every start i, and all rows sit back to back in one array, so a query
+// reads two entries of one row. Rows longer than parallelCutoff are built
+// with algo::parallel_for. Build is O(n log n) time and space.
+template<typename T, typename Op = MinMonoid<T>>
+class SparseTable {
+    std::vector<T> table;
+    std::vector<size_t> rowStart;
+    std::vector<uint8_t> lg; // floor(log2(len)) for len in [1, n]
+    int n = 0;
+    Op op;
+public:
+    SparseTable() = default;
+    explicit SparseTable(const std::vector<T>& data, Op op_func = Op(), size_t parallelCutoff = 1 << 16)
+        : lg(data.size() + 1, 0), n(static_cast<int>(data.size())), op(op_func) {
+        for (size_t i = 2; i < lg.size(); ++i) lg[i] = lg[i / 2] + 1;
+        size_t total = 0;
+        for (int k = 0; n && k <= lg[n]; ++k) {
+            rowStart.push_back(total);
+            total += n - (size_t(1) << k) + 1;
+        }
+        table.resize(total);
+        std::copy(data.begin(), data.end(), table.begin());
+        for (size_t k = 1; k < rowStart.size(); ++k) {
+            const T* prev = &table[rowStart[k - 1]];
+            T* row = &table[rowStart[k]];
+            size_t half = size_t(1) << (k - 1), len = n - 2 * half + 1;
+            auto fill = [&](size_t i) { row[i] = op(prev[i], prev[i + half]); };
+            if (len > parallelCutoff) algo::parallel_for(size_t(0), len, parallelCutoff, fill);
+            else for (size_t i = 0; i < len; ++i) fill(i);
+        }
+    }
+
+    T query(int l, int r) const { // [l, r)
+        if (l < 0 || r > n || l >= r) throw std::out_of_range("SparseTable query range is empty or out of bounds");
+        int k = lg[r - l];
+        const T* row = &table[rowStart[k]];
+        return op(row[l], row[r - (1 << k)]);
+    }
+    const T& operator[](int i) const { return table[i]; }
+    int size() const { return n; }
+};
+
+// Template-based disjoint sparse table for O(1) range queries with any
+// associative Op (sum, product, affine composition, ...), no idempotence
+// needed. Level h splits the array into blocks of 2^(h+1) and stores, for
+// each position, op from it to the middle of its block (left half) or from
+// the middle to it (right half). A query [l, r) uses the level where l and
+// r - 1 first fall into different halves, so it is one op of two entries.
+// Levels are independent, so large tables build them in parallel.
+template<typename T, typename Op = SumMonoid<T>>
+class DisjointSparseTable {
+    std::vector<T> table;
+    std::vector<uint8_t> lg;
+    int n = 0;
+    int levels = 0;
+    Op op;
+public:
+    DisjointSparseTable() = default;
+    explicit DisjointSparseTable(const std::vector<T>& data, Op op_func = Op(), size_t parallelCutoff = 1 << 16)
+        : n(static_cast<int>(data.size())), op(op_func) {
+        while ((size_t(1) << levels) < data.size()) ++levels;
+        // lg[x] = floor(log2(x)), for x = l ^ (r - 1) < 2^levels
+        lg.assign(size_t(1) << levels, 0);
+        for (size_t i = 2; i < lg.size(); ++i) lg[i] = lg[i / 2] + 1;
+        // Row `levels` holds the elements themselves, for one-element ranges
+        table.resize(size_t(levels + 1) * n);
+        std::copy(data.begin(), data.end(), table.begin() + size_t(levels) * n);
+        auto fillLevel = [&](int h) {
+            T* row = &table[size_t(h) * n];
+            size_t half = size_t(1) << h;
+            for (size_t mid = half; mid < size_t(n); mid += 2 * half) {
+                row[mid - 1] = data[mid - 1];
+                for (size_t i = mid - 1; i > mid - half; --i) row[i - 1] = op(data[i - 1], row[i]);
+                row[mid] = data[mid];
+                size_t end = std::min(mid + half, size_t(n));
+                for (size_t i = mid + 1; i < end; ++i) row[i] = op(row[i - 1], data[i]);
+            }
+        };
+        if (data.size() > parallelCutoff) algo::parallel_for(0, levels, 1, fillLevel);
+        else for (int h = 0; h < levels; ++h) fillLevel(h);
+    }
+
+    T query(int l, int r) const { // [l, r)
+        if (l < 0 || r > n || l >= r) throw std::out_of_range("DisjointSparseTable query range is empty or out of bounds");
+        --r;
+        if (l == r) return table[size_t(levels) * n + l];
+        const T* row = &table[size_t(lg[l ^ r]) * n];
+        return op(row[l], row[r]);
+    }
+    int size() const { return n; }
+};
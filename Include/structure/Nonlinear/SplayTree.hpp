@@ -0,0 +1,121 @@
+#pragma once
+#include "Tree.hpp"
+#include <memory>
+#include <utility>
+
+// Template-based top-down splay tree as a child of Tree<T>
+// Every access moves the key to the root, so operations are amortized
+// O(log n) and recently used keys are found in near O(1). Lookups restructure
+// the tree and therefore are not const.
+template<typename T, typename Alloc = std::allocator<TreeNode<T>>>
+class SplayTree : public Tree<T, TreeNode<T>, Alloc> {
+    using Node = TreeNode<T>;
+    using Base = Tree<T, TreeNode<T>, Alloc>;
+    size_t count = 0;
+public:
+    using Base::Base;
+    SplayTree(SplayTree&& other) noexcept : Base(std::move(other)), count(other.count) { other.count = 0; }
+    SplayTree& operator=(SplayTree&& other) noexcept {
+        Base::operator=(std::move(other));
+        count = other.count;
+        other.count = 0;
+        return *this;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    bool insert(const T& value) {
+        if (!this->root) {
+            this->root = this->create_node(value);
+            ++count;
+            return true;
+        }
+        Node* top = splay(this->root, value);
+        this->root = top;
+        if (!(value < top->data) && !(top->data < value)) return false;
+        Node* node = this->create_node(value);
+        if (value < top->data) {
+            node->left = top->left;
+            node->right = top;
+            top->left = nullptr;
+        } else {
+            node->right = top->right;
+            node->left = top;
+            top->right = nullptr;
+        }
+        this->root = node;
+        ++count;
+        return true;
+    }
+    bool remove(const T& value) {
+        if (!contains(value)) return false;
+        Node* old = this->root;
+        if (!old->left) {
+            this->root = old->right;
+        } else {
+            // value is larger than everything on the left, so splaying it
+            // there brings the maximum up with an empty right subtree
+            Node* top = splay(old->left, value);
+            top->right = old->right;
+            this->root = top;
+        }
+        this->destroy_node(old);
+        --count;
+        return true;
+    }
+    // Splays value (or its neighbour) to the root
+    bool contains(const T& value) {
+        if (!this->root) return false;
+        this->root = splay(this->root, value);
+        return !(value < this->root->data) && !(this->root->data < value);
+    }
+    void clear() {
+        Base::clear();
+        count = 0;
+    }
+private:
+    // Top-down splay: nodes passed on the way down hang off the right
+    // tree (larger keys) or left tree (smaller keys), then get reassembled
+    static Node* splay(Node* t, const T& value) {
+        Node *leftRoot = nullptr, *rightRoot = nullptr;
+        Node** leftHook = &leftRoot;  // right link of the left tree's maximum
+        Node** rightHook = &rightRoot; // left link of the right tree's minimum
+        while (true) {
+            if (value < t->data) {
+                if (!t->left) break;
+                if (value < t->left->data) {
+                    // Zig-zig: rotate right
+                    Node* y = t->left;
+                    t->left = y->right;
+                    y->right = t;
+                    t = y;
+                    if (!t->left) break;
+                }
+                *rightHook = t;
+                rightHook = &t->left;
+                t = t->left;
+            } else if (t->data < value) {
+                if (!t->right) break;
+                if (t->right->data < value) {
+                    // Zag-zag: rotate left
+                    Node* y = t->right;
+                    t->right = y->left;
+                    y->left = t;
+                    t = y;
+                    if (!t->right) break;
+                }
+                *leftHook = t;
+                leftHook = &t->right;
+                t = t->right;
+            } else {
+                break;
+            }
+        }
+        *leftHook = t->left;
+        *rightHook = t->right;
+        t->left = leftRoot;
+        t->right = rightRoot;
+        return t;
+    }
+};
\ No newline at end of file
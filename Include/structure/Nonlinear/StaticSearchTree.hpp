@@ -0,0 +1,150 @@
+#pragma once
+#include "Tree.hpp"
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Static (read-only) search trees over a sorted key set, stored as flat
+// arrays with implicit child offsets. Build them from any range or from a
+// Tree (e.g. an AVLTree or BinaryTree) once updates are done.
+
+// Collects, sorts and deduplicates keys
+template<typename T>
+std::vector<T> sorted_keys(std::vector<T> keys) {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end(),
+                           [](const T& a, const T& b) { return !(a < b) && !(b < a); }),
+               keys.end());
+    return keys;
+}
+template<typename T, typename NodeT, typename Alloc>
+std::vector<T> sorted_keys(const Tree<T, NodeT, Alloc>& tree) {
+    return sorted_keys(std::vector<T>(tree.begin(), tree.end()));
+}
+
+// Eytzinger (BFS-order) layout: children of slot k are 2k and 2k + 1
+// (1-based). The top levels share cache lines and the descent is branchless.
+template<typename T>
+class EytzingerTree {
+    std::vector<T> slots; // slots[0] unused
+public:
+    EytzingerTree() = default;
+    explicit EytzingerTree(std::vector<T> keys) {
+        keys = sorted_keys(std::move(keys));
+        slots.resize(keys.size() + 1);
+        size_t next = 0;
+        fill(keys, next, 1);
+    }
+    template<typename NodeT, typename Alloc>
+    explicit EytzingerTree(const Tree<T, NodeT, Alloc>& tree) : EytzingerTree(sorted_keys(tree)) {}
+
+    size_t size() const { return slots.size() - (slots.empty() ? 0 : 1); }
+    bool empty() const { return size() == 0; }
+
+    // Smallest key >= value, or nullptr
+    const T* lower_bound(const T& value) const {
+        size_t n = size(), k = 1;
+        while (k <= n) k = 2 * k + (slots[k] < value);
+        // Undo the right turns taken after the last left turn
+        while (k & 1) k >>= 1;
+        k >>= 1;
+        return k ? &slots[k] : nullptr;
+    }
+    bool contains(const T& value) const {
+        const T* found = lower_bound(value);
+        return found && !(value < *found);
+    }
+private:
+    void fill(std::vector<T>& keys, size_t& next, size_t k) {
+        if (k >= slots.size()) return;
+        fill(keys, next, 2 * k);
+        slots[k] = std::move(keys[next++]);
+        fill(keys, next, 2 * k + 1);
+    }
+};
+
+// Van Emde Boas layout: a perfect tree of height h is stored as its top
+// half (height h/2) followed by each bottom subtree, recursively. Every
+// subtree of height 2^i is contiguous, so a search touches O(log_B n) blocks
+// for any block size B without tuning. Child positions are computed from
+// per-depth tables (Brodal, Fagerberg and Jacob); the tree is padded to a
+// perfect shape with copies of the largest key.
+template<typename T>
+class VebTree {
+    std::vector<T> slots;
+    int levels = 0;
+    // For each depth d > 0: size of the top tree of the split that makes d
+    // the first level of a bottom tree, size of that bottom tree, and the
+    // depth of the enclosing subtree's root
+    std::vector<size_t> topSize, bottomSize;
+    std::vector<int> subtreeRoot;
+    size_t count = 0;
+    static constexpr int kMaxLevels = 64;
+public:
+    VebTree() = default;
+    explicit VebTree(std::vector<T> keys) {
+        keys = sorted_keys(std::move(keys));
+        count = keys.size();
+        if (keys.empty()) return;
+        while ((size_t(1) << levels) - 1 < keys.size()) ++levels;
+        topSize.assign(levels, 0);
+        bottomSize.assign(levels, 0);
+        subtreeRoot.assign(levels, 0);
+        buildTables(0, levels);
+        slots.resize((size_t(1) << levels) - 1, keys.back());
+        size_t pos[kMaxLevels];
+        size_t next = 0;
+        fill(keys, next, 1, 0, pos);
+    }
+    template<typename NodeT, typename Alloc>
+    explicit VebTree(const Tree<T, NodeT, Alloc>& tree) : VebTree(sorted_keys(tree)) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Smallest key >= value, or nullptr
+    const T* lower_bound(const T& value) const {
+        size_t pos[kMaxLevels];
+        const T* best = nullptr;
+        size_t bfs = 1;
+        for (int d = 0; d < levels; ++d) {
+            size_t p = position(bfs, d, pos);
+            if (slots[p] < value) {
+                bfs = 2 * bfs + 1;
+            } else {
+                best = &slots[p];
+                bfs = 2 * bfs;
+            }
+        }
+        return best;
+    }
+    bool contains(const T& value) const {
+        const T* found = lower_bound(value);
+        return found && !(value < *found);
+    }
+private:
+    void buildTables(int root, int height) {
+        if (height <= 1) return;
+        int top = height / 2, bottom = height - top, split = root + top;
+        topSize[split] = (size_t(1) << top) - 1;
+        bottomSize[split] = (size_t(1) << bottom) - 1;
+        subtreeRoot[split] = root;
+        buildTables(root, top);
+        buildTables(split, bottom);
+    }
+    // Array position of the node with 1-based BFS index bfs at depth d,
+    // given the positions of its ancestors in pos[0, d)
+    size_t position(size_t bfs, int d, size_t* pos) const {
+        size_t p = d == 0 ? 0 : pos[subtreeRoot[d]] + topSize[d] + (bfs & topSize[d]) * bottomSize[d];
+        pos[d] = p;
+        return p;
+    }
+    void fill(std::vector<T>& keys, size_t& next, size_t bfs, int d, size_t* pos) {
+        if (d == levels || next == keys.size()) return;
+        size_t p = position(bfs, d, pos);
+        fill(keys, next, 2 * bfs, d + 1, pos);
+        if (next < keys.size()) slots[p] = std::move(keys[next++]);
+        fill(keys, next, 2 * bfs + 1, d + 1, pos);
+    }
+};
\ No newline at end of file
@@ -1,83 +1,301 @@
 #pragma once
 #include <iostream>
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <cstddef>
 
 // Simple binary tree template
 // For general trees, more children can be added as needed
 
 template<typename T>
+struct TreeNode {
+    T data;
+    TreeNode* left;
+    TreeNode* right;
+    TreeNode(const T& val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+// Detects allocators that can drop all their nodes at once (ArenaAllocator)
+template<typename A, typename = void>
+struct has_bulk_release : std::false_type {};
+template<typename A>
+struct has_bulk_release<A, std::void_t<decltype(std::declval<A&>().release())>> : std::true_type {};
+
+// NodeT lets derived trees carry per-node metadata (e.g. AVL heights);
+// it only needs data, left and right members. Nodes come from Alloc, e.g.
+// ArenaAllocator<NodeT> from NodeArena.hpp.
+template<typename T, typename NodeT = TreeNode<T>, typename Alloc = std::allocator<NodeT>>
 class Tree {
 public:
-    struct Node {
-        T data;
-        Node* left;
-        Node* right;
-        Node(const T& val) : data(val), left(nullptr), right(nullptr) {}
-    };
+    using Node = NodeT;
+    using allocator_type = Alloc;
 
     Node* root;
 
-    Tree() : root(nullptr) {}
-    ~Tree() { clear(root); }
+    explicit Tree(const Alloc& allocator = Alloc()) : root(nullptr), alloc(allocator) {}
+    ~Tree() { clear(); }
+    // Trees own their nodes: movable, not copyable. A moved-from tree keeps
+    // a copy of the allocator so it stays usable.
+    Tree(const Tree&) = delete;
+    Tree& operator=(const Tree&) = delete;
+    Tree(Tree&& other) noexcept : root(other.root), alloc(other.alloc) { other.root = nullptr; }
+    Tree& operator=(Tree&& other) noexcept {
+        if (this != &other) {
+            clear();
+            root = other.root;
+            alloc = other.alloc;
+            other.root = nullptr;
+        }
+        return *this;
+    }
+
+    Alloc get_allocator() const { return alloc; }
 
+    // Frees every node. With an arena allocator that is not shared and
+    // trivially destructible nodes this is O(1).
+    void clear() {
+        if constexpr (has_bulk_release<Alloc>::value && std::is_trivially_destructible<Node>::value) {
+            if (alloc.release()) {
+                root = nullptr;
+                return;
+            }
+        }
+        clear(root);
+        root = nullptr;
+    }
+    // Frees the subtree at node iteratively: rotating left children up
+    // flattens it into a right spine without any stack
     void clear(Node* node) {
-        if (!node) return;
-        clear(node->left);
-        clear(node->right);
-        delete node;
+        while (node) {
+            if (Node* left = node->left) {
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } else {
+                Node* right = node->right;
+                destroy_node(node);
+                node = right;
+            }
+        }
+    }
+
+protected:
+    Alloc alloc;
+
+    template<typename... Args>
+    Node* create_node(Args&&... args) {
+        Node* node = std::allocator_traits<Alloc>::allocate(alloc, 1);
+        try {
+            std::allocator_traits<Alloc>::construct(alloc, node, std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator_traits<Alloc>::deallocate(alloc, node, 1);
+            throw;
+        }
+        return node;
     }
+    void destroy_node(Node* node) {
+        std::allocator_traits<Alloc>::destroy(alloc, node);
+        std::allocator_traits<Alloc>::deallocate(alloc, node, 1);
+    }
+
+public:
+    // Bidirectional in-order iterator. It keeps the root-to-node path on an
+    // inline stack (spilling to the heap only past kInlineDepth levels), so
+    // iterating a balanced tree never allocates.
+    class const_iterator {
+        friend class Tree;
+        static constexpr size_t kInlineDepth = 48;
+        const Node* root = nullptr;
+        const Node* inlinePath[kInlineDepth];
+        std::vector<const Node*> spill;
+        size_t depth = 0;
+
+        const Node* top() const { return depth <= kInlineDepth ? inlinePath[depth - 1] : spill.back(); }
+        void push(const Node* node) {
+            if (depth < kInlineDepth) inlinePath[depth] = node;
+            else spill.push_back(node);
+            ++depth;
+        }
+        const Node* pop() {
+            const Node* node = top();
+            if (depth > kInlineDepth) spill.pop_back();
+            --depth;
+            return node;
+        }
+        void pushLeftSpine(const Node* node) { for (; node; node = node->left) push(node); }
+        void pushRightSpine(const Node* node) { for (; node; node = node->right) push(node); }
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+        reference operator*() const { return top()->data; }
+        pointer operator->() const { return &top()->data; }
+        const_iterator& operator++() {
+            const Node* node = top();
+            if (node->right) {
+                push(node->right);
+                pushLeftSpine(node->right->left);
+            } else {
+                // Climb until we leave a left subtree
+                const Node* child;
+                do { child = pop(); } while (depth > 0 && top()->right == child);
+            }
+            return *this;
+        }
+        const_iterator& operator--() {
+            if (depth == 0) {
+                pushRightSpine(root); // --end() is the maximum
+                return *this;
+            }
+            const Node* node = top();
+            if (node->left) {
+                push(node->left);
+                pushRightSpine(node->left->right);
+            } else {
+                const Node* child;
+                do { child = pop(); } while (depth > 0 && top()->left == child);
+            }
+            return *this;
+        }
+        const_iterator operator++(int) { const_iterator tmp = *this; ++*this; return tmp; }
+        const_iterator operator--(int) { const_iterator tmp = *this; --*this; return tmp; }
+        bool operator==(const const_iterator& other) const {
+            if (depth != other.depth) return false;
+            return depth == 0 || top() == other.top();
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+    using iterator = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    const_iterator begin() const {
+        const_iterator it = end();
+        it.pushLeftSpine(root);
+        return it;
+    }
+    const_iterator end() const {
+        const_iterator it;
+        it.root = root;
+        return it;
+    }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    // Range adaptor for reverse in-order loops: for (auto& x : tree.reversed())
+    struct ReverseRange {
+        const_reverse_iterator first, last;
+        const_reverse_iterator begin() const { return first; }
+        const_reverse_iterator end() const { return last; }
+    };
+    ReverseRange reversed() const { return {rbegin(), rend()}; }
+
+    // Morris traversals: O(1) extra memory. They temporarily thread right
+    // pointers and restore them before returning, so the tree must not be
+    // accessed concurrently; visit must not modify the tree.
+    template<typename F>
+    void morris_inorder(F visit) { morris(visit, true); }
+    template<typename F>
+    void morris_preorder(F visit) { morris(visit, false); }
+
+    // Traversals below use an explicit stack, so skewed trees cannot
+    // overflow the call stack.
 
     // Utility: Inorder traversal
     void inorder(std::function<void(const T&)> visit) const { inorder(root, visit); }
-    void inorder(Node* node, std::function<void(const T&)> visit) const {
-        if (!node) return;
-        inorder(node->left, visit);
-        visit(node->data);
-        inorder(node->right, visit);
-    }
+    void inorder(Node* node, std::function<void(const T&)> visit) const { inorderImpl(node, visit, false); }
 
     // Utility: Preorder traversal
     void preorder(std::function<void(const T&)> visit) const { preorder(root, visit); }
-    void preorder(Node* node, std::function<void(const T&)> visit) const {
-        if (!node) return;
-        visit(node->data);
-        preorder(node->left, visit);
-        preorder(node->right, visit);
-    }
+    void preorder(Node* node, std::function<void(const T&)> visit) const { preorderImpl(node, visit, false); }
 
     // Utility: Postorder traversal
     void postorder(std::function<void(const T&)> visit) const { postorder(root, visit); }
-    void postorder(Node* node, std::function<void(const T&)> visit) const {
-        if (!node) return;
-        postorder(node->left, visit);
-        postorder(node->right, visit);
-        visit(node->data);
-    }
+    void postorder(Node* node, std::function<void(const T&)> visit) const { postorderImpl(node, visit, false); }
 
     // Utility: Reverse inorder traversal
     void reverse_inorder(std::function<void(const T&)> visit) const { reverse_inorder(root, visit); }
-    void reverse_inorder(Node* node, std::function<void(const T&)> visit) const {
-        if (!node) return;
-        reverse_inorder(node->right, visit);
-        visit(node->data);
-        reverse_inorder(node->left, visit);
-    }
+    void reverse_inorder(Node* node, std::function<void(const T&)> visit) const { inorderImpl(node, visit, true); }
 
     // Utility: Reverse preorder traversal
     void reverse_preorder(std::function<void(const T&)> visit) const { reverse_preorder(root, visit); }
-    void reverse_preorder(Node* node, std::function<void(const T&)> visit) const {
-        if (!node) return;
-        visit(node->data);
-        reverse_preorder(node->right, visit);
-        reverse_preorder(node->left, visit);
-    }
+    void reverse_preorder(Node* node, std::function<void(const T&)> visit) const { preorderImpl(node, visit, true); }
 
     // Utility: Reverse postorder traversal
     void reverse_postorder(std::function<void(const T&)> visit) const { reverse_postorder(root, visit); }
-    void reverse_postorder(Node* node, std::function<void(const T&)> visit) const {
+    void reverse_postorder(Node* node, std::function<void(const T&)> visit) const { postorderImpl(node, visit, true); }
+
+protected:
+    // Lets derived trees position an iterator by pushing the path from the
+    // root down to the target node
+    static void push_path(const_iterator& it, const Node* node) { it.push(node); }
+
+private:
+    // Mirrored traversals swap the roles of left and right
+    static Node* first(Node* node, bool mirrored) { return mirrored ? node->right : node->left; }
+    static Node* second(Node* node, bool mirrored) { return mirrored ? node->left : node->right; }
+
+    static void inorderImpl(Node* node, const std::function<void(const T&)>& visit, bool mirrored) {
+        std::vector<Node*> stack;
+        while (node || !stack.empty()) {
+            for (; node; node = first(node, mirrored)) stack.push_back(node);
+            node = stack.back(); stack.pop_back();
+            visit(node->data);
+            node = second(node, mirrored);
+        }
+    }
+    static void preorderImpl(Node* node, const std::function<void(const T&)>& visit, bool mirrored) {
         if (!node) return;
-        reverse_postorder(node->right, visit);
-        reverse_postorder(node->left, visit);
-        visit(node->data);
+        std::vector<Node*> stack{node};
+        while (!stack.empty()) {
+            node = stack.back(); stack.pop_back();
+            visit(node->data);
+            if (second(node, mirrored)) stack.push_back(second(node, mirrored));
+            if (first(node, mirrored)) stack.push_back(first(node, mirrored));
+        }
+    }
+    static void postorderImpl(Node* node, const std::function<void(const T&)>& visit, bool mirrored) {
+        std::vector<Node*> stack;
+        Node* last = nullptr;
+        while (node || !stack.empty()) {
+            for (; node; node = first(node, mirrored)) stack.push_back(node);
+            Node* top = stack.back();
+            if (second(top, mirrored) && second(top, mirrored) != last) {
+                node = second(top, mirrored);
+            } else {
+                visit(top->data);
+                last = top;
+                stack.pop_back();
+            }
+        }
+    }
+    template<typename F>
+    void morris(F& visit, bool inorder) {
+        Node* node = root;
+        while (node) {
+            if (!node->left) {
+                visit(static_cast<const T&>(node->data));
+                node = node->right;
+                continue;
+            }
+            Node* pred = node->left;
+            while (pred->right && pred->right != node) pred = pred->right;
+            if (!pred->right) {
+                pred->right = node; // thread back to node
+                if (!inorder) visit(static_cast<const T&>(node->data));
+                node = node->left;
+            } else {
+                pred->right = nullptr;
+                if (inorder) visit(static_cast<const T&>(node->data));
+                node = node->right;
+            }
+        }
     }
-}; 
\ No newline at end of file
+};
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+// Wall-clock nanoseconds per operation for one call of f doing ops operations
+template<typename F>
+double nsPerOp(size_t ops, F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
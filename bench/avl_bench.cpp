@@ -0,0 +1,31 @@
+// AVLTree scaling benchmark: per-operation cost of insert, contains and
+// remove for growing key counts. With O(log n) operations, ns/op divided
+// by log2(n) stays roughly flat (cache misses still grow with n).
+#include "BenchUtil.hpp"
+#include "structure/Nonlinear/AVLTree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+int main() {
+    std::printf("%10s %7s %12s %12s %12s %14s\n", "keys", "height", "insert ns", "contains ns", "remove ns",
+                "insert/log2n");
+    for (size_t n : {100000u, 1000000u, 10000000u}) {
+        std::vector<int> keys(n);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+        AVLTree<int> tree;
+        double insert = nsPerOp(n, [&] { for (int k : keys) tree.insert(k); });
+        int height = tree.height();
+        size_t found = 0;
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+        double contains = nsPerOp(n, [&] { for (int k : keys) found += tree.contains(k); });
+        double remove = nsPerOp(n, [&] { for (int k : keys) tree.remove(k); });
+        if (found != n || !tree.empty()) return 1;
+        std::printf("%10zu %7d %12.0f %12.0f %12.0f %14.1f\n", n, height, insert, contains, remove,
+                    insert / std::log2(double(n)));
+    }
+}
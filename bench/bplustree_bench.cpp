@@ -0,0 +1,68 @@
+// BPlusTree against AVLTree and std::map: random inserts, random lookups,
+// 100-key range scans and (for BPlusTree) bulk loading, on shuffled int
+// keys. AVLTree is a set, so it stores the keys only.
+#include "BenchUtil.hpp"
+#include "structure/Nonlinear/AVLTree.hpp"
+#include "structure/Nonlinear/BPlusTree.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+constexpr int kScanLength = 100;
+constexpr size_t kScans = 100000;
+
+int main() {
+    std::printf("%8s %-22s %10s %10s %12s %10s\n", "keys", "structure", "insert ns", "find ns", "scan100 ns", "bulk ns");
+    for (size_t n : {1000000u, 4000000u}) {
+        std::vector<int> keys(n);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+        std::vector<int> probes(keys);
+        std::shuffle(probes.begin(), probes.end(), std::mt19937(7));
+        std::vector<int> scanStarts(kScans);
+        std::mt19937 rng(3);
+        for (int& s : scanStarts) s = static_cast<int>(rng() % (n - kScanLength));
+        long sink = 0;
+
+        {
+            BPlusTree<int, int> tree;
+            double insert = nsPerOp(n, [&] { for (int k : keys) tree.insert(k, k); });
+            double find = nsPerOp(n, [&] { for (int k : probes) sink += *tree.find(k); });
+            double scan = nsPerOp(kScans, [&] {
+                for (int s : scanStarts) tree.scan(s, s + kScanLength, [&](int, int v) { sink += v; });
+            });
+            std::vector<std::pair<int, int>> sorted(n);
+            for (size_t i = 0; i < n; ++i) sorted[i] = {int(i), int(i)};
+            double bulk = nsPerOp(n, [&] { tree.bulk_load(sorted.begin(), sorted.end()); });
+            std::printf("%8zu %-22s %10.0f %10.0f %12.0f %10.1f\n", n, "BPlusTree<int,int>", insert, find, scan, bulk);
+        }
+        {
+            AVLTree<int> tree;
+            double insert = nsPerOp(n, [&] { for (int k : keys) tree.insert(k); });
+            double find = nsPerOp(n, [&] { for (int k : probes) sink += tree.contains(k); });
+            double scan = nsPerOp(kScans, [&] {
+                for (int s : scanStarts) {
+                    auto it = tree.iterator_at(tree.rank(s));
+                    for (int i = 0; i < kScanLength; ++i, ++it) sink += *it;
+                }
+            });
+            std::printf("%8zu %-22s %10.0f %10.0f %12.0f %10s\n", n, "AVLTree<int>", insert, find, scan, "-");
+        }
+        {
+            std::map<int, int> tree;
+            double insert = nsPerOp(n, [&] { for (int k : keys) tree.emplace(k, k); });
+            double find = nsPerOp(n, [&] { for (int k : probes) sink += tree.find(k)->second; });
+            double scan = nsPerOp(kScans, [&] {
+                for (int s : scanStarts) {
+                    auto it = tree.lower_bound(s);
+                    for (int i = 0; i < kScanLength; ++i, ++it) sink += it->second;
+                }
+            });
+            std::printf("%8zu %-22s %10.0f %10.0f %12.0f %10s\n", n, "std::map<int,int>", insert, find, scan, "-");
+        }
+        if (sink == 42) std::printf("\n");
+    }
+}
@@ -0,0 +1,70 @@
+// Heap and IndexedHeap by arity on a Dijkstra-like workload. The push/pop
+// columns time the queue alone on the (distance, vertex) entries a lazy
+// Dijkstra run produces: all pushes first, then all pops. The Dijkstra
+// columns time whole runs on a random sparse graph.
+#include "BenchUtil.hpp"
+#include "Algorithms/Dijkstra.hpp"
+#include "structure/Nonlinear/Heap.hpp"
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using Graph = std::vector<std::vector<std::pair<int, long long>>>;
+using Entry = std::pair<long long, int>;
+
+struct EntryLess {
+    bool operator()(const Entry& a, const Entry& b) const { return a.first < b.first; }
+};
+
+// Lazy deletion Dijkstra; also records every entry it pushes
+template<size_t Arity>
+std::vector<long long> dijkstraLazy(const Graph& adj, int src, std::vector<Entry>* pushed = nullptr) {
+    std::vector<long long> dist(adj.size(), std::numeric_limits<long long>::max());
+    Heap<Entry, EntryLess, Arity> pq;
+    dist[src] = 0;
+    pq.push({0, src});
+    while (!pq.empty()) {
+        auto [d, u] = pq.pop_value();
+        if (d > dist[u]) continue;
+        for (auto [v, w] : adj[u]) {
+            if (d + w < dist[v]) {
+                dist[v] = d + w;
+                pq.push({dist[v], v});
+                if (pushed) pushed->push_back({dist[v], v});
+            }
+        }
+    }
+    return dist;
+}
+
+template<size_t Arity>
+void row(const Graph& adj, size_t edges, const std::vector<Entry>& entries, const std::vector<long long>& expected) {
+    Heap<Entry, EntryLess, Arity> heap;
+    heap.reserve(entries.size());
+    long long checksum = 0;
+    double pushNs = nsPerOp(entries.size(), [&] { for (const Entry& e : entries) heap.push(e); });
+    double popNs = nsPerOp(entries.size(), [&] { while (!heap.empty()) checksum += heap.pop_value().first; });
+    std::vector<long long> lazy, indexed;
+    double lazyNs = nsPerOp(edges, [&] { lazy = dijkstraLazy<Arity>(adj, 0); });
+    double indexedNs = nsPerOp(edges, [&] { indexed = dijkstra_indexed<long long, Arity>(adj, 0); });
+    if (lazy != expected || indexed != expected || checksum == 0) std::printf("mismatch at arity %zu\n", Arity);
+    std::printf("%6zu %10.1f %10.1f %14.1f %16.1f\n", Arity, pushNs, popNs, lazyNs, indexedNs);
+}
+
+int main() {
+    const int n = 1 << 20;
+    const size_t edges = size_t(8) * n;
+    Graph adj(n);
+    std::mt19937 rng(1);
+    for (size_t i = 0; i < edges; ++i) adj[rng() % n].push_back({int(rng() % n), (long long)(rng() % 100000)});
+    std::vector<Entry> entries;
+    std::vector<long long> expected = dijkstraLazy<2>(adj, 0, &entries);
+
+    std::printf("%d vertices, %zu edges, %zu queue entries\n", n, edges, entries.size());
+    std::printf("%6s %10s %10s %14s %16s\n", "arity", "push ns", "pop ns", "Heap ns/edge", "Indexed ns/edge");
+    row<2>(adj, edges, entries, expected);
+    row<4>(adj, edges, entries, expected);
+    row<8>(adj, edges, entries, expected);
+}
@@ -0,0 +1,73 @@
+// LazySegmentTree range add against point updates on a SegmentTree and a
+// plain array, for range lengths from a few elements to the whole array.
+// Each op is one range add followed by one range query over the same
+// length; ranges are generated before timing.
+#include "BenchUtil.hpp"
+#include "structure/Nonlinear/LazySegmentTree.hpp"
+#include "structure/Nonlinear/SegmentTree.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+std::vector<std::pair<int, int>> randomRanges(int n, int len, size_t count) {
+    std::mt19937 rng(7);
+    std::vector<std::pair<int, int>> ranges(count);
+    for (auto& range : ranges) {
+        int l = static_cast<int>(rng() % (n - len + 1));
+        range = {l, l + len};
+    }
+    return ranges;
+}
+
+int main() {
+    const int n = 1 << 20;
+    const size_t ops = 200000;
+    // The baselines cost O(len) per op, so they get fewer ops at long lengths
+    const size_t baselineWork = size_t(1) << 27;
+
+    std::vector<SumLen<long long>> sums(n, {1, 1});
+    std::vector<Extremum<long long>> extrema(n, {1, false});
+    LazySegmentTree<RangeAddSum<long long>> lazySum(sums);
+    LazySegmentTree<RangeAddMin<long long>> lazyMin(extrema);
+    SegmentTree<long long, SumMonoid<long long>> pointSum(std::vector<long long>(n, 1));
+    std::vector<long long> plain(n, 1);
+
+    std::printf("%d elements, add + sum (add + min for LazyMin), ns per op\n", n);
+    std::printf("%8s %10s %10s %12s %10s\n", "length", "LazySum", "LazyMin", "SegmentTree", "array");
+    for (int len : {8, 128, 4096, 65536, n}) {
+        auto ranges = randomRanges(n, len, ops);
+        size_t baselineOps = std::max<size_t>(1, std::min(ops, baselineWork / len));
+        long long sink = 0;
+        double lazySumNs = nsPerOp(ops, [&] {
+            for (auto [l, r] : ranges) {
+                lazySum.apply(l, r, 1);
+                sink += lazySum.query(l, r).sum;
+            }
+        });
+        double lazyMinNs = nsPerOp(ops, [&] {
+            for (auto [l, r] : ranges) {
+                lazyMin.apply(l, r, 1);
+                sink += lazyMin.query(l, r).value;
+            }
+        });
+        double pointNs = nsPerOp(baselineOps, [&] {
+            for (size_t i = 0; i < baselineOps; ++i) {
+                auto [l, r] = ranges[i];
+                for (int p = l; p < r; ++p) pointSum.update(p, pointSum.query(p, p + 1) + 1);
+                sink += pointSum.query(l, r);
+            }
+        });
+        double plainNs = nsPerOp(baselineOps, [&] {
+            for (size_t i = 0; i < baselineOps; ++i) {
+                auto [l, r] = ranges[i];
+                long long sum = 0;
+                for (int p = l; p < r; ++p) sum += ++plain[p];
+                sink += sum;
+            }
+        });
+        if (sink == 0) return 1;
+        std::printf("%8d %10.0f %10.0f %12.0f %10.0f\n", len, lazySumNs, lazyMinNs, pointNs, plainNs);
+    }
+}
@@ -0,0 +1,128 @@
+// PairingHeap against the array heaps on two priority-queue workloads:
+// Dijkstra on a random sparse graph (Heap with lazy deletion, IndexedHeap
+// and PairingHeap with decrease_key) and the discrete-event hold model,
+// where each step pops the earliest event and schedules a later one.
+#include "BenchUtil.hpp"
+#include "Algorithms/Dijkstra.hpp"
+#include "structure/Nonlinear/Heap.hpp"
+#include "structure/Nonlinear/NodeArena.hpp"
+#include "structure/Nonlinear/PairingHeap.hpp"
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using Graph = std::vector<std::vector<std::pair<int, long long>>>;
+using Entry = std::pair<long long, int>;
+
+struct EntryLess {
+    bool operator()(const Entry& a, const Entry& b) const { return a.first < b.first; }
+};
+
+// Lazy deletion: a vertex is pushed again on every improvement and stale
+// entries are skipped when popped
+template<size_t Arity>
+std::vector<long long> dijkstraLazy(const Graph& adj, int src) {
+    std::vector<long long> dist(adj.size(), std::numeric_limits<long long>::max());
+    Heap<Entry, EntryLess, Arity> pq;
+    dist[src] = 0;
+    pq.push({0, src});
+    while (!pq.empty()) {
+        auto [d, u] = pq.pop_value();
+        if (d > dist[u]) continue;
+        for (auto [v, w] : adj[u]) {
+            if (d + w < dist[v]) {
+                dist[v] = d + w;
+                pq.push({dist[v], v});
+            }
+        }
+    }
+    return dist;
+}
+
+template<typename PH>
+std::vector<long long> dijkstraPairing(const Graph& adj, int src) {
+    std::vector<long long> dist(adj.size(), std::numeric_limits<long long>::max());
+    std::vector<typename PH::handle> handles(adj.size());
+    std::vector<char> queued(adj.size(), 0);
+    PH pq;
+    dist[src] = 0;
+    handles[src] = pq.push({0, src});
+    queued[src] = 1;
+    while (!pq.empty()) {
+        auto [d, u] = pq.pop_value();
+        queued[u] = 0;
+        for (auto [v, w] : adj[u]) {
+            if (d + w < dist[v]) {
+                dist[v] = d + w;
+                if (queued[v]) {
+                    pq.decrease_key(handles[v], {dist[v], v});
+                } else {
+                    handles[v] = pq.push({dist[v], v});
+                    queued[v] = 1;
+                }
+            }
+        }
+    }
+    return dist;
+}
+
+// Hold model: start with pending events, then pop the earliest and push it
+// back at a random later time, holds times
+template<typename Q>
+double holdModel(Q& q, size_t pending, size_t holds) {
+    std::mt19937 rng(2);
+    for (size_t i = 0; i < pending; ++i) q.push(double(rng() % 1000000));
+    double checksum = 0;
+    for (size_t i = 0; i < holds; ++i) {
+        double t = q.pop_value();
+        checksum += t;
+        q.push(t + double(rng() % 1000000) / 1000.0);
+    }
+    return checksum;
+}
+
+int main() {
+    const int n = 1 << 20;
+    const size_t edges = size_t(8) * n;
+    Graph adj(n);
+    std::mt19937 rng(1);
+    for (size_t i = 0; i < edges; ++i) adj[rng() % n].push_back({int(rng() % n), (long long)(rng() % 100000)});
+
+    using Pairing = PairingHeap<Entry, EntryLess>;
+    using PairingArena = PairingHeap<Entry, EntryLess, ArenaAllocator<PairingNode<Entry>>>;
+    std::vector<long long> expected, dist;
+    std::printf("Dijkstra, %d vertices, %zu edges, ns per edge\n", n, edges);
+    std::printf("%24s %8.1f\n", "Heap<2> lazy", nsPerOp(edges, [&] { expected = dijkstraLazy<2>(adj, 0); }));
+    std::printf("%24s %8.1f\n", "Heap<4> lazy", nsPerOp(edges, [&] { dist = dijkstraLazy<4>(adj, 0); }));
+    if (dist != expected) return 1;
+    std::printf("%24s %8.1f\n", "IndexedHeap<4>", nsPerOp(edges, [&] { dist = dijkstra_indexed(adj, 0); }));
+    if (dist != expected) return 1;
+    std::printf("%24s %8.1f\n", "PairingHeap", nsPerOp(edges, [&] { dist = dijkstraPairing<Pairing>(adj, 0); }));
+    if (dist != expected) return 1;
+    std::printf("%24s %8.1f\n", "PairingHeap + arena", nsPerOp(edges, [&] { dist = dijkstraPairing<PairingArena>(adj, 0); }));
+    if (dist != expected) return 1;
+
+    const size_t pending = 1000000, holds = 10000000;
+    double sum2 = 0, sum4 = 0, sumPairing = 0, sumArena = 0;
+    std::printf("\nHold model, %zu pending events, %zu holds, ns per hold\n", pending, holds);
+    std::printf("%24s %8.1f\n", "Heap<2>", nsPerOp(holds, [&] {
+        Heap<double> q;
+        sum2 = holdModel(q, pending, holds);
+    }));
+    std::printf("%24s %8.1f\n", "Heap<4>", nsPerOp(holds, [&] {
+        Heap<double, std::less<double>, 4> q;
+        sum4 = holdModel(q, pending, holds);
+    }));
+    std::printf("%24s %8.1f\n", "PairingHeap", nsPerOp(holds, [&] {
+        PairingHeap<double> q;
+        sumPairing = holdModel(q, pending, holds);
+    }));
+    std::printf("%24s %8.1f\n", "PairingHeap + arena", nsPerOp(holds, [&] {
+        PairingHeap<double, std::less<double>, ArenaAllocator<PairingNode<double>>> q;
+        sumArena = holdModel(q, pending, holds);
+    }));
+    if (sum2 != sum4 || sum2 != sumPairing || sum2 != sumArena) return 1;
+}
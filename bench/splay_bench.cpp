@@ -0,0 +1,97 @@
+// SplayTree against AVLTree and a skip list on Zipf-distributed lookups.
+// Keys are ranked by popularity in random order, so hot keys are spread
+// over the key space; the query stream is generated before timing.
+#include "BenchUtil.hpp"
+#include "structure/Nonlinear/AVLTree.hpp"
+#include "structure/Nonlinear/SplayTree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Minimal skip list set (p = 1/2), as the usual probabilistic baseline
+class SkipList {
+    static constexpr int kMaxLevel = 32;
+    struct Node {
+        int key;
+        std::vector<Node*> next;
+        Node(int k, int levels) : key(k), next(levels, nullptr) {}
+    };
+    Node head{0, kMaxLevel};
+    int levels = 1;
+    std::mt19937 rng{1};
+public:
+    ~SkipList() {
+        for (Node* node = head.next[0]; node;) {
+            Node* next = node->next[0];
+            delete node;
+            node = next;
+        }
+    }
+    void insert(int key) {
+        Node* update[kMaxLevel];
+        Node* node = &head;
+        for (int i = levels - 1; i >= 0; --i) {
+            while (node->next[i] && node->next[i]->key < key) node = node->next[i];
+            update[i] = node;
+        }
+        if (node->next[0] && node->next[0]->key == key) return;
+        int level = 1;
+        while (level < kMaxLevel && (rng() & 1)) ++level;
+        for (; levels < level; ++levels) update[levels] = &head;
+        Node* fresh = new Node(key, level);
+        for (int i = 0; i < level; ++i) {
+            fresh->next[i] = update[i]->next[i];
+            update[i]->next[i] = fresh;
+        }
+    }
+    bool contains(int key) const {
+        const Node* node = &head;
+        for (int i = levels - 1; i >= 0; --i)
+            while (node->next[i] && node->next[i]->key < key) node = node->next[i];
+        node = node->next[0];
+        return node && node->key == key;
+    }
+};
+
+// Query stream where the key of popularity rank r has weight 1 / r^s
+std::vector<int> zipfQueries(const std::vector<int>& keysByRank, double s, size_t count) {
+    std::vector<double> cdf(keysByRank.size());
+    double total = 0;
+    for (size_t r = 0; r < cdf.size(); ++r) cdf[r] = total += 1.0 / std::pow(double(r + 1), s);
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> uniform(0, total);
+    std::vector<int> queries(count);
+    for (int& q : queries)
+        q = keysByRank[std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin()];
+    return queries;
+}
+
+int main() {
+    const size_t n = 1000000, lookups = 5000000;
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+    SplayTree<int> splay;
+    AVLTree<int> avl;
+    SkipList skip;
+    for (int k : keys) {
+        splay.insert(k);
+        avl.insert(k);
+        skip.insert(k);
+    }
+    std::printf("%zu keys, %zu lookups, ns per lookup\n", n, lookups);
+    std::printf("%8s %10s %10s %10s\n", "zipf s", "SplayTree", "AVLTree", "SkipList");
+    for (double s : {0.0, 0.8, 0.99, 1.2, 1.5}) {
+        std::vector<int> queries = zipfQueries(keys, s, lookups);
+        size_t found = 0;
+        double splayNs = nsPerOp(lookups, [&] { for (int q : queries) found += splay.contains(q); });
+        double avlNs = nsPerOp(lookups, [&] { for (int q : queries) found += avl.contains(q); });
+        double skipNs = nsPerOp(lookups, [&] { for (int q : queries) found += skip.contains(q); });
+        if (found != 3 * lookups) return 1;
+        std::printf("%8.2f %10.0f %10.0f %10.0f\n", s, splayNs, avlNs, skipNs);
+    }
+}
@@ -0,0 +1,46 @@
+// Static search layouts against the pointer-based AVLTree: contains() on
+// VebTree, EytzingerTree, AVLTree and std::binary_search over the sorted
+// keys, for trees from cache-resident to far larger than the last level
+// cache. Keys are even numbers and half the lookups miss.
+#include "BenchUtil.hpp"
+#include "structure/Nonlinear/AVLTree.hpp"
+#include "structure/Nonlinear/StaticSearchTree.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+int main() {
+    const size_t lookups = 2000000;
+    std::printf("%d lookups, ns per lookup\n", int(lookups));
+    std::printf("%10s %10s %10s %10s %10s\n", "keys", "VebTree", "Eytzinger", "AVLTree", "sorted");
+    for (size_t n : {size_t(1) << 12, size_t(1) << 16, size_t(1) << 20, size_t(1) << 22}) {
+        std::vector<int> keys(n);
+        for (size_t i = 0; i < n; ++i) keys[i] = int(2 * i);
+        std::vector<int> order = keys;
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+        // Random insertion order scatters the AVL nodes over the heap, as
+        // in a long-lived tree
+        AVLTree<int> avl;
+        for (int k : order) avl.insert(k);
+        VebTree<int> veb(avl);
+        EytzingerTree<int> eytzinger(avl);
+
+        std::mt19937 rng(7);
+        std::vector<int> queries(lookups);
+        for (int& q : queries) q = int(rng() % (2 * n));
+
+        size_t found = 0;
+        double vebNs = nsPerOp(lookups, [&] { for (int q : queries) found += veb.contains(q); });
+        double eytzingerNs = nsPerOp(lookups, [&] { for (int q : queries) found += eytzinger.contains(q); });
+        double avlNs = nsPerOp(lookups, [&] { for (int q : queries) found += avl.contains(q); });
+        double sortedNs = nsPerOp(lookups, [&] {
+            for (int q : queries) found += std::binary_search(keys.begin(), keys.end(), q);
+        });
+        size_t hits = 0;
+        for (int q : queries) hits += q % 2 == 0;
+        if (found != 4 * hits) return 1;
+        std::printf("%10zu %10.1f %10.1f %10.1f %10.1f\n", n, vebNs, eytzingerNs, avlNs, sortedNs);
+    }
+}